@@ -28,264 +28,1700 @@
 //              Cancel destructive, Reset clean slate). All setters and
 //              operator()(...) now EnsureStaging_() to avoid null deref after
 //              Cancel(). Added L27/L28 tests.
+// 2026-10-16 — SetMaxActive(n, policy) concurrency cap; Priority() setter;
+//              evicted/rejected runs complete like Stop(). Added L33/L34 tests.
+// 2026-10-16 — public Animation::Scheduler: instantiable per window/timeline,
+//              own FPS/timer/clock, O(1) Suspend()/Resume(); Default() keeps
+//              the process-wide behavior. Added L35/L36 tests.
+// 2026-10-16 — opt-in visibility culling (SetCulling): hidden owners skip
+//              ticks while time advances; catch-up on the next visible frame.
+// 2026-10-16 — Animation::Batch defers timer arm/disarm to scope end; idle
+//              grace keeps the timer armed briefly after the set empties.
+//              Added L38 test.
+// 2026-10-16 — State::Step derives leg/direction/completion from total run
+//              time (division), so stalls resolve in O(1) without phase drift;
+//              OnLeg(skipped) hook. Added L39 test.
+// 2026-10-16 — fixed-timestep mode (SetFixedStep) with OnRender(alpha);
+//              frame sweep split into StepAll()/Purge(). Added L40 test.
+// 2026-10-16 — per-run MaxRate(hz): rate groups on a shared grid; the timer
+//              sleeps until the earliest due group. Added L41 test.
+// 2026-10-16 — adaptive FPS governor (SetAutoFPS) driven by frame cost and
+//              timer lateness; GetEffectiveFPS(). Added L42 test.
+// 2026-10-16 — optional timerfd frame source on Linux (SetFrameSource):
+//              deadline-stamped frames from a helper thread; FrameStats
+//              jitter histogram for both sources. Added L43 test.
+// 2026-10-16 — Immediate()/SetImmediate(): Play()/Replay() deliver the t=0
+//              frame synchronously, start time aligned to it. Added L44 test.
+// 2026-10-16 — FrameTime(): per-frame timestamp shared by Play/Pause/Resume/
+//              Progress; a new run wakes a timer sleeping for rate groups.
+//              Added L45 test.
+// 2026-10-16 — OnFrame(owner, fn(now, dt)) per-frame hooks stepped by the
+//              scheduler frame; CancelFrame(id). Added L46 test.
+// 2026-10-16 — SetMotionMode(FULL/REDUCED/INSTANT): process-wide reduced
+//              motion (30 FPS cap, quarter timing) or synchronous completion.
+//              Added L47 test.
+// 2026-10-16 — State shares its spec (SpecRef); PlayMany(owners, spec,
+//              tick_factory, stagger) starts a list on one spec with one
+//              timer start. Added L48 test.
+// 2026-10-16 — copy-on-write specs: staging, run and last_spec_ share one
+//              SpecRef; setters clone only a shared spec. Scheduler recycles
+//              State memory. Replay() allocates nothing. Added L49 test.
+// 2026-10-16 — allocation-free construction: staging starts as the shared
+//              default spec; the first setter clones it. Added L50 test.
+// 2026-10-16 — SmallFunction/SmallEvent: spec hooks, tick and easing use
+//              48-byte inline storage; member delegates and small captures
+//              never allocate. Added L51 test.
+// 2026-10-16 — AnimHandle: 32-bit generational run ids over a slot table;
+//              State has no Animation back-pointer, moving an Animation
+//              rebinds its slot. Launch()/AnimateValue are fire-and-forget
+//              and return a handle. Added L52 test.
+// 2026-10-16 — property runs: Launch/AnimateValue keyed by (owner, prop)
+//              supersede a live run on the key in its slot, starting from
+//              its last value (ValueTrack/ValueTraits). Added L53 test.
+// 2026-10-16 — Retarget(to, mode) on value runs: same State, path restarts
+//              at the current value with a Hermite velocity term;
+//              ValueTraits is now a component view. Added L54 test.
+// 2026-10-16 — RUN_SPRING runs (Spring/SmoothDamp): closed-form damped
+//              spring per segment, SetTarget() keeps x and v, ends at rest.
+//              Reduced motion scales springs too. Added L55 test.
+// 2026-10-16 — RUN_DECAY runs (Decay/Bounds/DecayEnd): exponential fling
+//              with its rest position and end time known at Play(); past a
+//              bound it settles on the bound spring. Added L56 test.
+// 2026-10-16 — linked runs (Link/ProgressSource): tween progress from an
+//              input scalar, stepped by ProgressSource::Set() through the
+//              same StepTween(); never armed the timer. Added L57 test.
+// 2026-10-16 — SetClockSource(): run clock slaved to an external clock;
+//              drift slewed (max_slew), seeks jump and fire on_seek. Wall()
+//              stays local for timer/governor/idle. Added L58 test.
+// 2026-10-16 — virtual clock (SetVirtualClock/AdvanceTime): Clock() under
+//              Wall() is swappable without a jump; ConsoleAnim pumps
+//              simulated time instead of sleeping. Added L59 test.
 //
 // Note: file banner path reflects package directory (Animation/).
 
 #include "Animation.h"
 
+#ifdef PLATFORM_LINUX
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
 using namespace Upp;
 
 /*==================== Scheduler ====================*/
 namespace {
 
-struct Scheduler {
-    // Singleton accessor (U++-style; safe for shutdown + memdiag).
-    static Scheduler& Inst() { return Single<Scheduler>(); }
-
-    // State
-    Vector<Animation::State*> active; // Owns State* pointers
-    TimeCallback ticker;              // Timer for frame updates
-    bool running = false;             // Scheduler active state
-    int  timer_id = 0;                // Timer identifier for validation
-    int64 manual_last_now = 0;        // Monotonic time for manual ticking
-    bool sweeping = false;            // true while RunFrame() iterates 'active'
-
-    // Frame pacing
-    int fps     = 60;
-    int step_ms = 1000 / 60;
-
-    // Change FPS safely while running: re-arms timer with new step.
-    void SetFPSInternal(int f) {
-        fps     = clamp(f, 1, 240);
-        step_ms = max(1, 1000 / fps);
-        if (running) {
-            Stop();   // kills timer, bumps timer_id
-            Start();  // re-arms with new step_ms
-        }
+// Every live scheduler, so process-wide helpers (KillAllFor/Finalize) reach
+// instances created per window as well as the default one.
+Vector<Animation::Scheduler*>& Schedulers()
+{
+    static Vector<Animation::Scheduler*> list;
+    return list;
+}
+
+// Process-wide motion mode (Animation::SetMotionMode).
+int& MotionModeRef()
+{
+    static int mode = Animation::MOTION_FULL;
+    return mode;
+}
+
+// Frame step for a rate; reduced motion caps it at 30 FPS.
+int StepFor(int fps)
+{
+    if (MotionModeRef() == Animation::MOTION_REDUCED)
+        fps = min(fps, 30);
+    return max(1, 1000 / fps);
+}
+
+// Run slots behind AnimHandle, shared by every scheduler (UI thread only).
+// A slot's generation advances when its run is retired; free slots are
+// reused oldest first, so a stale handle meets a reused slot as late as
+// possible.
+struct RunSlot {
+    Animation::State* state = nullptr;   // live run; nullptr when free
+    Animation*        anim  = nullptr;   // Animation wrapping the run, if any
+    dword             gen   = 1;         // never 0, so no live id is 0
+    int               next  = -1;        // free list link
+};
+
+struct RunSlotTable {
+    Vector<RunSlot> slot;
+    int head = -1, tail = -1;            // FIFO of free slots
+};
+
+const dword SLOT_INDEX_MASK = (1u << AnimHandle::INDEX_BITS) - 1;
+const dword SLOT_GEN_MAX    = (1u << AnimHandle::GEN_BITS) - 1;
+
+RunSlotTable& RunSlots()
+{
+    static RunSlotTable t;
+    return t;
+}
+
+dword AllocSlot(Animation::State* s)
+{
+    RunSlotTable& t = RunSlots();
+    int i = t.head;
+    if (i >= 0) {
+        t.head = t.slot[i].next;
+        if (t.head < 0) t.tail = -1;
+    }
+    else {
+        i = t.slot.GetCount();
+        ASSERT(dword(i) <= SLOT_INDEX_MASK);
+        t.slot.Add();
+    }
+    RunSlot& r = t.slot[i];
+    r.state = s;
+    r.anim  = nullptr;
+    r.next  = -1;
+    return (r.gen << AnimHandle::INDEX_BITS) | dword(i);
+}
+
+RunSlot* FindSlot(dword id)
+{
+    RunSlotTable& t = RunSlots();
+    int i = int(id & SLOT_INDEX_MASK);
+    if (!id || i >= t.slot.GetCount())
+        return nullptr;
+    RunSlot& r = t.slot[i];
+    return r.state && r.gen == id >> AnimHandle::INDEX_BITS ? &r : nullptr;
+}
+
+void FreeSlot(RunSlot& r)
+{
+    RunSlotTable& t = RunSlots();
+    int i = int(&r - t.slot.begin());
+    r.state = nullptr;
+    r.anim  = nullptr;
+    r.next  = -1;
+    if (r.gen == SLOT_GEN_MAX)           // retired: a wrapped generation would
+        return;                          // let stale handles resolve again
+    ++r.gen;
+    if (t.tail >= 0) t.slot[t.tail].next = i;
+    else             t.head = i;
+    t.tail = i;
+}
+
+// Reduced motion: a quarter of the time. Spring time scales with
+// 1 / sqrt(stiffness / mass), so stiffness x16 and damping x4 keep the shape;
+// decay time with 1 / friction, and friction x4 with velocity x4 keeps the
+// resting position (velocities run 4x faster on the compressed clock).
+void Reduce(Animation::Staging& w)
+{
+    w.duration_ms = max(1, w.duration_ms / 4);
+    w.delay_ms   /= 4;
+    w.stiffness  *= 16;
+    w.damping    *= 4;
+    w.friction   *= 4;
+    w.velocity   *= 4;
+}
+
+// Owner is on screen: its window is open, it and all parents are visible,
+// and some part of it survives clipping by its parents / top window.
+bool IsOwnerVisible(Ctrl& c)
+{
+    return c.IsOpen() && c.IsVisible() && !c.GetVisibleScreenRect().IsEmpty();
+}
+
+} // namespace
+
+/*==================== Frame source (timerfd) ====================
+  A helper thread blocks on a timerfd armed periodically with absolute
+  CLOCK_MONOTONIC deadlines, so wake-up latency never shifts the grid. Each
+  expiry publishes its deadline and posts at most one pending callback to the
+  GUI thread: a busy GUI thread gets one frame with the latest deadline
+  instead of a queue of stale ones. Only the thread touches 'pending'/'quit'
+  and 'deadline_ns' concurrently; everything else is GUI-thread state. */
+#ifdef PLATFORM_LINUX
+
+struct Animation::Scheduler::FrameSource {
+    Scheduler&         sched;
+    Thread             thread;
+    int                fd = -1;
+    Atomic             quit;
+    Atomic             pending;
+    std::atomic<int64> deadline_ns;     // CLOCK_MONOTONIC of the latest expiry
+    int64              armed_ns  = 0;   // deadlines up to here are stale
+    int64              ms_offset = 0;   // msecs() - monotonic ms
+    int64              us_offset = 0;   // usecs() - monotonic us
+    int                period_ms = 0;   // armed period (0 = disarmed)
+
+    explicit FrameSource(Scheduler& s) : sched(s) { quit = 0; pending = 0; deadline_ns = 0; }
+    ~FrameSource()                      { Close(); }
+
+    static int64    MonoNs();
+    static timespec ToTs(int64 ns)      { timespec ts; ts.tv_sec = ns / 1000000000; ts.tv_nsec = ns % 1000000000; return ts; }
+    static int64    FromTs(const timespec& ts) { return int64(ts.tv_sec) * 1000000000 + ts.tv_nsec; }
+
+    bool Open();
+    void Close();
+    void Arm(int period);
+    void Disarm();
+    void Run();
+};
+
+int64 Animation::Scheduler::FrameSource::MonoNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return FromTs(ts);
+}
+
+bool Animation::Scheduler::FrameSource::Open()
+{
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd < 0)
+        return false;
+    int64 mono = MonoNs();
+    ms_offset = msecs() - mono / 1000000;
+    us_offset = usecs() - mono / 1000;
+    quit = 0;
+    if (!thread.Run([this] { Run(); })) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// Join the thread: expire the timer at once so read() returns and sees 'quit'.
+void Animation::Scheduler::FrameSource::Close()
+{
+    if (fd < 0) return;
+    quit = 1;
+    itimerspec its = {};
+    its.it_value.tv_nsec = 1;
+    timerfd_settime(fd, 0, &its, nullptr);
+    thread.Wait();
+    close(fd);
+    fd = -1;
+    KillTimeCallback(this);
+}
+
+void Animation::Scheduler::FrameSource::Arm(int period)
+{
+    period_ms = period;
+    armed_ns  = MonoNs();
+    itimerspec its;
+    its.it_interval = ToTs(int64(period) * 1000000);
+    its.it_value    = ToTs(armed_ns + int64(period) * 1000000);
+    timerfd_settime(fd, TFD_TIMER_ABSTIME, &its, nullptr);
+}
+
+// A frame posted before this is dropped by SourceFrame() (not running, or
+// its deadline precedes the next Arm()).
+void Animation::Scheduler::FrameSource::Disarm()
+{
+    period_ms = 0;
+    itimerspec its = {};
+    timerfd_settime(fd, 0, &its, nullptr);
+}
+
+// Thread body. The latest deadline is the next expiry minus the interval,
+// both taken from the kernel's absolute schedule.
+void Animation::Scheduler::FrameSource::Run()
+{
+    while (!quit) {
+        uint64 expirations;
+        if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (quit) break;
+        itimerspec cur;
+        timerfd_gettime(fd, &cur);
+        int64 period = FromTs(cur.it_interval);
+        if (period <= 0)
+            continue; // disarmed meanwhile
+        deadline_ns = MonoNs() + FromTs(cur.it_value) - period;
+        if (!pending.exchange(1))
+            PostCallback([this] { pending = 0; sched.SourceFrame(); }, this);
+    }
+}
+
+// Posted timerfd frame: the frame time is the deadline mapped into the
+// msecs() domain, not the moment this callback runs; lateness feeds the
+// governor, whose rate changes re-arm the period.
+void Animation::Scheduler::SourceFrame()
+{
+    if (!running || !source || virtual_clock) return;
+    int64 mono = source->deadline_ns;
+    if (mono <= source->armed_ns) return; // stale (disarmed / re-armed since)
+    int64 now  = mono / 1000000 + source->ms_offset - clock_skip;
+    int64 late = Wall() - now;
+    RecordFrame(mono / 1000 + source->us_offset);
+    int64 t0 = usecs();
+    RunFrame(now);
+    Govern((usecs() - t0) / 1000.0, late);
+    if (running && source->period_ms != step_ms) {
+        source->Arm(step_ms);
+        stats_last_us   = 0;
+        stats_expect_us = step_ms * 1000;
+    }
+}
+
+#else
+
+// timerfd is Linux-only: SetFrameSource(FRAME_TIMERFD) fails, no source exists.
+struct Animation::Scheduler::FrameSource {
+    explicit FrameSource(Scheduler&) {}
+    bool Open()      { return false; }
+    void Arm(int)    {}
+    void Disarm()    {}
+};
+
+void Animation::Scheduler::SourceFrame() {}
+
+#endif
+
+// Default(): process-wide instance (U++-style; safe for shutdown + memdiag).
+Animation::Scheduler& Animation::Scheduler::Default()
+{
+    return Single<Scheduler>();
+}
+
+Animation::Scheduler::Scheduler()
+{
+    RunSlots();   // outlives every scheduler (destroyed in reverse order)
+    Schedulers().Add(this);
+}
+
+Animation::Scheduler::~Scheduler()
+{
+    Finalize();
+    source.Clear(); // joins the timerfd thread, drops a posted frame
+    Vector<Scheduler*>& list = Schedulers();
+    for (int i = 0; i < list.GetCount(); ++i)
+        if (list[i] == this) { list.Remove(i); break; }
+}
+
+// Wall clock: Clock() (msecs() or the virtual clock) minus everything spent
+// suspended.
+int64 Animation::Scheduler::Wall() const
+{
+    return (suspended ? suspend_ms : Clock()) - clock_skip;
+}
+
+// Scheduler clock seen by runs: wall clock (slaved: plus the offset to the
+// external clock), or simulation time in fixed-step mode.
+int64 Animation::Scheduler::Now() const
+{
+    return fixed_hz > 0 ? int64(sim_ms) : RunClock();
+}
+
+int64 Animation::Scheduler::RunClock() const
+{
+    return Wall() + llround(slave_ms);
+}
+
+// SetClockSource(): attach aligns at once (not a seek); detach keeps the offset.
+void Animation::Scheduler::SetClockSource(Function<double()> clock, double max_slew, int seek_ms,
+                                          Event<int64> seek)
+{
+    ext_clock   = pick(clock);
+    on_seek     = pick(seek);
+    slave_slew  = clamp(max_slew, 0.0, 1.0);
+    slave_seek  = max(1, seek_ms);
+    slave_err   = 0;
+    slave_seeks = 0;
+    slave_wall  = Wall();
+    if (ext_clock)
+        slave_ms = ext_clock() - slave_wall;
+}
+
+// Once per frame: error = external - run clock. Within seek range the offset
+// moves by at most max_slew of the wall time since the last measurement
+// (the clock runs up to that much faster or slower); beyond it, it jumps.
+int64 Animation::Scheduler::Slave(int64 wall)
+{
+    if (ext_clock) {
+        const double err   = ext_clock() - (wall + slave_ms);
+        const double limit = slave_slew * max<int64>(0, wall - slave_wall);
+        slave_wall = wall;
+        slave_err  = err;
+        if (fabs(err) > slave_seek) {
+            const int64 before = wall + llround(slave_ms);
+            slave_ms += err;
+            ++slave_seeks;
+            if (on_seek) on_seek(wall + llround(slave_ms) - before);
+        }
+        else
+            slave_ms += clamp(err, -limit, limit);
+    }
+    return wall + llround(slave_ms);
+}
+
+// FrameTime(): published frame timestamp; the clock is sampled only when no
+// frame cadence is running (idle, sleeping for a rate group, or suspended).
+// Inside a Batch the sample is shared by every call up to EndBatch().
+int64 Animation::Scheduler::FrameTime()
+{
+    if (sweeping || (frame_sync && ((running && !sleeping) || batch_depth > 0)))
+        return frame_now;
+    if (fixed_hz > 0 && !running)
+        SyncSim();
+    frame_now  = Now();
+    frame_sync = true;
+    return frame_now;
+}
+
+// Idle fixed-step scheduler: no frames step the sim clock, so it takes
+// over the time elapsed since the last frame (the slip it had is kept).
+// Otherwise a run started now would begin in the past and its first frame
+// would catch up fixed_max steps at once.
+void Animation::Scheduler::SyncSim()
+{
+    const int64 now = RunClock();
+    sim_ms  += double(max<int64>(0, now - sim_wall));
+    sim_wall = now;
+}
+
+// SetFixedStep(): enter/leave fixed-step mode without a time discontinuity.
+void Animation::Scheduler::SetFixedStep(int hz, int max_steps_per_frame)
+{
+    int64 wall = RunClock();
+    if (fixed_hz > 0 && hz <= 0)
+        clock_skip += wall - int64(sim_ms); // wall clock resumes from sim time
+    else if (fixed_hz <= 0 && hz > 0) {
+        sim_ms   = double(wall);
+        sim_wall = wall;
+        sim_acc  = 0;
+    }
+    fixed_hz  = max(0, min(hz, 1000));
+    fixed_max = max(1, max_steps_per_frame);
+}
+
+// Change FPS safely while running: re-arms timer with new step.
+// The governor (if enabled) restarts from the new target.
+void Animation::Scheduler::SetFPS(int f)
+{
+    fps     = clamp(f, 1, 240);
+    eff_fps = fps;
+    step_ms = StepFor(fps);
+    gov_over = gov_under = 0;
+    if (running) {
+        Stop();   // kills timer, bumps timer_id
+        Start();  // re-arms with new step_ms
+    }
+}
+
+// Effective rate change from the governor: the next re-arm picks it up.
+void Animation::Scheduler::SetEffectiveFPS(int f)
+{
+    eff_fps = clamp(f, 1, fps);
+    step_ms = StepFor(eff_fps);
+    gov_over = gov_under = 0;
+}
+
+// Motion mode changed: Instant snaps every run in flight to its end (one at
+// a time; hooks may start or cancel others), then the frame step follows.
+// The timer is re-armed only if runs or frame hooks are left to drive.
+void Animation::Scheduler::ApplyMotionMode()
+{
+    if (MotionModeRef() == MOTION_INSTANT)
+        for (;;) {
+            State* live = nullptr;
+            for (State* s : active)
+                if (s && !s->dying) { live = s; break; }
+            if (!live) break;
+            live->reverse = live->spec->yoyo; // end state, as in Play()
+            Complete(live);
+        }
+    step_ms = StepFor(eff_fps);
+    if (running) {
+        Stop();
+        EnsureRunningIfAnyUnpaused();
+    }
+}
+
+void Animation::Scheduler::SetAutoFPS(bool b, int min_fps)
+{
+    auto_fps     = b;
+    auto_min_fps = clamp(min_fps, 1, 240);
+    gov_cost = gov_late = 0;
+    SetEffectiveFPS(fps);
+}
+
+// Governor: smooth cost/lateness, then step the effective FPS down by a
+// quarter after 8 overloaded frames (> 60% of budget) or back up after
+// 60 relaxed frames (< 30% of budget).
+void Animation::Scheduler::Govern(double cost_ms, int64 late_ms)
+{
+    if (!auto_fps) return;
+    gov_cost += 0.2 * (cost_ms - gov_cost);
+    gov_late += 0.2 * (double(max<int64>(0, late_ms)) - gov_late);
+
+    const double budget = 1000.0 / eff_fps;
+    const double load   = gov_cost + gov_late;
+    if (load > 0.6 * budget) {
+        gov_under = 0;
+        if (++gov_over >= 8 && eff_fps > auto_min_fps)
+            SetEffectiveFPS(max(auto_min_fps, eff_fps * 3 / 4));
+    }
+    else if (load < 0.3 * budget) {
+        gov_over = 0;
+        if (++gov_under >= 60 && eff_fps < fps)
+            SetEffectiveFPS(min(fps, eff_fps * 4 / 3 + 1));
+    }
+    else
+        gov_over = gov_under = 0;
+}
+
+// Suspend(): O(1) freeze. The clock stops, so runs resume where they were.
+void Animation::Scheduler::Suspend()
+{
+    if (suspended) return;
+    suspend_ms = Clock();
+    suspended  = true;
+    Stop();
+}
+
+// Resume(): skip the suspended interval and re-arm if anything needs ticking.
+void Animation::Scheduler::Resume()
+{
+    if (!suspended) return;
+    clock_skip += Clock() - suspend_ms;
+    suspended   = false;
+    EnsureRunningIfAnyUnpaused();
+}
+
+// Stop timer if there is nothing to advance (all paused, dying or linked,
+// no hooks).
+void Animation::Scheduler::MaybeStopIfAllPaused()
+{
+    if (HasLiveHooks())
+        return;
+    for (State* s : active)
+        if (s && !s->paused && !s->dying && !s->linked)
+            return; // at least one needs ticking
+    Idle();
+}
+
+// Ensure timer runs if there is something to advance.
+void Animation::Scheduler::EnsureRunningIfAnyUnpaused()
+{
+    if (HasLiveHooks()) { Start(); return; }
+    for (State* s : active)
+        if (s && !s->paused && !s->dying && !s->linked) { Start(); return; }
+    // all paused: nothing to do
+}
+
+// Finalize: stop and purge all animations; detach back-pointers first.
+void Animation::Scheduler::Finalize()
+{
+    running = false;
+    ++timer_id;
+    ticker.Kill();
+    if (source)
+        source->Disarm();
+
+    // Phase 1: retire the runs; Animations keep a forward progress snapshot.
+    const int64 now = FrameTime();
+    for (State* s : active)
+        if (s && s->handle)
+            Retire(s, s->Progress(now));
+    // Phase 2: delete states and clear.
+    for (State* s : active)
+        DeleteState(s);
+    active.Clear();
+    hooks.Clear();
+    FreeSpare();
+    manual_last_now = 0;
+}
+
+// States are recycled: a destroyed State's memory is kept (up to 64) so a
+// Play()/Replay() cycle does not go back to the heap.
+Animation::State* Animation::Scheduler::NewState()
+{
+    State* s = spare.IsEmpty() ? new State : new(spare.Pop()) State;
+    s->handle = AllocSlot(s);
+    return s;
+}
+
+void Animation::Scheduler::DeleteState(State* s)
+{
+    if (!s) return;
+    if (s->handle)
+        Retire(s, 0.0);
+    if (spare.GetCount() >= 64) {
+        delete s;
+        return;
+    }
+    s->~State();
+    spare.Add(s);
+}
+
+void Animation::Scheduler::FreeSpare()
+{
+    for (State* s : spare)
+        ::operator delete(s);
+    spare.Clear();
+}
+
+// Start/stop timer loop. A suspended scheduler never arms its timer.
+// Inside a Batch the decision is left to EndBatch(). An idle-but-armed
+// timer is simply put back to work (no re-arm); one sleeping until a rate
+// group is due is pulled back to the next frame.
+void Animation::Scheduler::Start()
+{
+    if (batch_depth > 0) return;
+    idle_since = -1;
+    if (suspended) return;
+    if (running) {
+        if (sleeping && !source) {
+            sleeping  = false;
+            armed_due = Wall() + step_ms;
+            stats_expect_us = 0; // irregular interval; not jitter
+            ticker.Set(step_ms, callback1(this, &Scheduler::TickTimer, timer_id));
+        }
+        return;
+    }
+    running  = true;
+    sleeping = false;
+    int current_id = ++timer_id;
+    armed_due = Wall() + step_ms;
+    stats_last_us   = 0; // no interval across an idle gap
+    stats_expect_us = step_ms * 1000;
+    if (virtual_clock)
+        return;          // frames come from AdvanceTime()
+    if (source)
+        source->Arm(step_ms);
+    else
+        ticker.Set(step_ms, callback1(this, &Scheduler::TickTimer, current_id));
+}
+
+void Animation::Scheduler::Stop()
+{
+    idle_since = -1;
+    if (!running) return;
+    running    = false;
+    frame_sync = false;
+    ++timer_id; // invalidate queued ticks
+    ticker.Kill();
+    if (source)
+        source->Disarm();
+}
+
+// Nothing left to advance: disarm now, or keep the timer running out the
+// grace period (re-checked every frame) in case new work arrives shortly.
+void Animation::Scheduler::Idle()
+{
+    if (batch_depth > 0 || !running) return;
+    if (idle_grace_ms <= 0) {
+        Stop();
+        return;
+    }
+    int64 now = Wall();
+    if (idle_since < 0)
+        idle_since = now;
+    else if (now - idle_since >= idle_grace_ms)
+        Stop();
+}
+
+// EndBatch(): outermost Batch closed → settle the timer once.
+void Animation::Scheduler::EndBatch()
+{
+    if (--batch_depth > 0) return;
+    EnsureRunningIfAnyUnpaused();
+    MaybeStopIfAllPaused();
+}
+
+// Number of states that still count towards the cap.
+int Animation::Scheduler::LiveCount() const
+{
+    int n = 0;
+    for (State* s : active)
+        if (s && !s->dying) ++n;
+    return n;
+}
+
+int Animation::Scheduler::GetCount() const
+{
+    return LiveCount();
+}
+
+// Lowest-priority live state (oldest wins ties), or nullptr.
+Animation::State* Animation::Scheduler::FindLowest() const
+{
+    State* low = nullptr;
+    for (State* s : active)
+        if (s && !s->dying && (!low || s->spec->priority < low->spec->priority))
+            low = s;
+    return low;
+}
+
+// Oldest live state (insertion order), or nullptr.
+Animation::State* Animation::Scheduler::FindOldest() const
+{
+    for (State* s : active)
+        if (s && !s->dying) return s;
+    return nullptr;
+}
+
+// Snap a state to its end value and fire on_finish (Stop() semantics).
+// The Animation is detached first so re-entrant Play() from on_finish
+// starts a clean run. 'scheduled' == false for a rejected newcomer.
+void Animation::Scheduler::Complete(State* s, bool scheduled)
+{
+    Retire(s, 1.0);
+    s->Tick(s->EndValue());
+    if (s->spec->on_finish) s->spec->on_finish();
+    if (scheduled) Remove(s);
+    else           DeleteState(s);
+}
+
+// Pick the state that must give way for 'incoming' (nullptr when trimming).
+// Returns 'incoming' itself if the newcomer loses: under CAP_EVICT_LOWEST
+// when it ranks below every active run, under CAP_REJECT_NEW unless it
+// outranks every active run (then the lowest one gives way).
+Animation::State* Animation::Scheduler::PickVictim(State* incoming) const
+{
+    if (cap_policy == CAP_EVICT_OLDEST)
+        return FindOldest();
+    State* low = FindLowest();
+    if (!incoming || !low)
+        return low;
+    if (cap_policy == CAP_REJECT_NEW) {
+        for (State* s : active)
+            if (s && !s->dying && s != incoming && s->spec->priority >= incoming->spec->priority)
+                return incoming;
+        return low;
+    }
+    return incoming->spec->priority < low->spec->priority ? incoming : low;
+}
+
+// Enforce the cap against the current set (after SetMaxActive lowered it).
+void Animation::Scheduler::TrimToCap()
+{
+    if (max_active <= 0) return;
+    while (LiveCount() > max_active)
+        if (State* v = PickVictim(nullptr))
+            Complete(v);
+        else
+            break;
+}
+
+// Re-evaluate owner visibility at most every cull_ms.
+void Animation::Scheduler::UpdateCulling(int64 now)
+{
+    if (!cull || now < cull_next) return;
+    cull_next = now + cull_ms;
+    for (State* s : active)
+        if (s && !s->dying && !s->linked)
+            s->culled = s->owner && !IsOwnerVisible(*s->owner);
+}
+
+void Animation::Scheduler::SetCulling(bool b, int check_ms)
+{
+    cull      = b;
+    cull_ms   = max(1, check_ms);
+    cull_next = 0; // re-check on the next frame
+    if (!cull)
+        for (State* s : active)
+            if (s) s->culled = false;
+}
+
+void Animation::Scheduler::SetMaxActive(int n, int policy)
+{
+    max_active = max(0, n);
+    cap_policy = clamp(policy, (int)CAP_EVICT_OLDEST, (int)CAP_REJECT_NEW);
+    TrimToCap();
+}
+
+// Add/remove active states. Returns false if the cap rejected 's'
+// (it has then been completed and freed).
+bool Animation::Scheduler::Add(State* s)
+{
+    s->sched = this;
+    if (max_active > 0) {
+        while (LiveCount() >= max_active) {
+            State* v = PickVictim(s);
+            if (v == s) {
+                Complete(s, false);
+                return false;
+            }
+            if (!v) break;
+            Complete(v);
+        }
+    }
+    if (cull && s->owner && !s->linked)
+        s->culled = !IsOwnerVisible(*s->owner);
+    active.Add(s);
+    if (!s->linked)
+        Start();
+    return true;
+}
+
+void Animation::Scheduler::Remove(State* st)
+{
+    if (!st) return;
+    if (sweeping) { // never mutate 'active' mid-iteration
+        st->dying = true;
+        return;
+    }
+    for (int i = 0; i < active.GetCount(); ++i) {
+        if (active[i] == st) {
+            DeleteState(active[i]);
+            active.Remove(i);
+            break;
+        }
+    }
+    MaybeStopIfAllPaused(); // frame hooks keep the timer
+}
+
+// PlayMany(): one shared spec for the whole list; the runs enter the set
+// under a Batch, so the timer is started (at most) once.
+void Animation::Scheduler::PlayMany(const Vector<Ctrl*>& owners, const Staging& spec,
+                                    TickFactory tick_factory, int stagger_ms)
+{
+    const int motion = MotionModeRef();
+    Staging sp = spec;
+    stagger_ms = max(0, stagger_ms);
+    if (motion == MOTION_REDUCED) {
+        Reduce(sp);
+        stagger_ms /= 4;
+    }
+    const SpecRef shared = SpecRef::Make(pick(sp));
+    const bool  first = shared->immediate < 0 ? immediate : shared->immediate > 0;
+    const int64 now   = FrameTime();
+
+    Batch batch(*this);
+    active.Reserve(active.GetCount() + owners.GetCount());
+    for (int i = 0; i < owners.GetCount(); ++i) {
+        Ctrl* c = owners[i];
+        if (!c) continue;
+        State* s = NewState();
+        s->owner    = c;
+        s->spec     = shared;
+        s->sched    = this;
+        s->start_ms = now + int64(i) * stagger_ms;
+        if (tick_factory)
+            s->tick = tick_factory(i, *c);
+        if (shared->on_start) shared->on_start();
+        if (motion == MOTION_INSTANT) {
+            s->reverse = shared->yoyo;
+            Complete(s, false);
+            continue;
+        }
+        LinkRun(s);
+        if (Add(s) && (first || s->linked))
+            StepFirst(s);
+    }
+}
+
+/*---------------- Runs addressed by handle ----------------*/
+
+Animation::State* Animation::Scheduler::Resolve(AnimHandle h)
+{
+    RunSlot* r = FindSlot(h.id);
+    return r ? r->state : nullptr;
+}
+
+// Commit 'spec' as a new run. A 'watcher' Animation gets the handle before
+// on_start fires, so on_start may already Cancel()/Stop() the run; a run
+// that on_start ended never enters the active set and is reclaimed here.
+// A property run takes over the slot of the live run on its key.
+AnimHandle Animation::Scheduler::StartRun(Ctrl* owner, SpecRef spec, Animation* watcher, int prop)
+{
+    // Reduced motion shortens this run only (a private copy); a cached
+    // spec keeps the original.
+    const int motion = MotionModeRef();
+    if (motion == MOTION_REDUCED)
+        Reduce(spec.Write());
+
+    State* s = NewState();
+    if (State* old = prop && owner ? Resolve(FindProperty(*owner, prop)) : nullptr) {
+        RunSlot* r = FindSlot(old->handle); // supersede: same handle, old run ends silently
+        FreeSlot(*FindSlot(s->handle));
+        s->handle   = old->handle;
+        old->handle = 0;
+        r->state    = s;
+        Remove(old);
+    }
+    AnimHandle h(s->handle);
+    s->owner    = owner;
+    s->spec     = pick(spec);
+    s->sched    = this;
+    s->prop     = prop;
+    s->start_ms = FrameTime();
+
+    if (watcher) {
+        if (RunSlot* old = FindSlot(watcher->live_.id))
+            old->anim = nullptr;          // a previous run continues unwatched
+        FindSlot(h.id)->anim = watcher;
+        watcher->live_ = h;
+    }
+
+    if (motion == MOTION_INSTANT) {       // complete here; never scheduled
+        s->reverse = s->spec->yoyo;       // yoyo runs end on a reverse leg
+        if (s->spec->on_start) s->spec->on_start();
+        if (s->handle) Complete(s, false);
+        else           DeleteState(s);
+        return h;
+    }
+
+    const bool first = s->spec->immediate < 0 ? immediate : s->spec->immediate > 0;
+    if (s->spec->on_start) s->spec->on_start();
+    if (!s->handle) {
+        DeleteState(s);
+        return h;
+    }
+    LinkRun(s);
+    if (Add(s) && (first || s->linked))   // a linked run shows its source position now
+        StepFirst(s);
+    return h;
+}
+
+AnimHandle Animation::Scheduler::Launch(Ctrl& owner, Staging spec, int prop)
+{
+    return StartRun(&owner, SpecRef::Make(pick(spec)), nullptr, prop);
+}
+
+// Live run keyed (owner, prop); a linear scan like FindOldest/FindLowest.
+AnimHandle Animation::Scheduler::FindProperty(Ctrl& owner, int prop) const
+{
+    if (prop)
+        for (State* s : active)
+            if (s && s->handle && !s->dying && s->prop == prop && s->owner == &owner)
+                return AnimHandle(s->handle);
+    return AnimHandle();
+}
+
+// Tweens with a live source are stepped by it; anything else plays on time.
+void Animation::Scheduler::LinkRun(State* s)
+{
+    ProgressSource* src = ~s->spec->link;
+    s->linked = src && s->spec->kind == RUN_TWEEN;
+    if (s->linked)
+        src->runs.Add(AnimHandle(s->handle));
+}
+
+// End of a run for its handle: the slot generation advances (every copy of
+// the handle is now dead) and a wrapping Animation caches 'progress'.
+void Animation::Scheduler::Retire(State* s, double progress)
+{
+    RunSlot* r = FindSlot(s->handle);
+    s->handle = 0;
+    if (!r) return;
+    Animation* a = r->anim;
+    FreeSlot(*r);
+    if (a) a->_OnStateRemoved(progress);
+}
+
+// Reversible freeze; the timer may stop if everything is paused.
+void Animation::Scheduler::PauseRun(State* s)
+{
+    if (s->paused) return;
+    s->elapsed_ms += FrameTime() - s->start_ms;
+    s->paused = true;
+    MaybeStopIfAllPaused();
+}
+
+void Animation::Scheduler::ResumeRun(State* s)
+{
+    if (!s->paused) return;
+    s->start_ms = FrameTime();
+    s->paused = false;
+    if (s->linked)
+        StepFirst(s);           // catch up with input received while paused
+    else
+        EnsureRunningIfAnyUnpaused();
+}
+
+// Abort: optional on_cancel, then retire with a forward progress snapshot
+// and remove (deferred-safe).
+void Animation::Scheduler::CancelRun(State* s, bool fire_cancel)
+{
+    if (fire_cancel && s->spec->on_cancel)
+        s->spec->on_cancel();
+    if (!s->handle)
+        return;                           // on_cancel ended it already
+    Retire(s, s->Progress(FrameTime()));
+    Remove(s);
+}
+
+// Kill all animations for a given Ctrl or dead owners; Progress=0.0.
+void Animation::Scheduler::KillAllFor(Ctrl& c)
+{
+    for (int i = active.GetCount() - 1; i >= 0; --i) {
+        State* s = active[i];
+        if (s && (!s->owner || s->owner == &c)) {
+            Retire(s, 0.0);         // handle dies now, Progress=0
+            s->dying = true;        // defer delete to next sweep
+        }
+    }
+    for (FrameHook& h : hooks)
+        if (!h.owner || h.owner == &c)
+            h.dying = true;
+    // Defer actual free to RunFrame(); avoids re-entrancy.
+}
+
+// Advance all active animations to 'now' (sweep phase; caller sets 'sweeping').
+// Finished states are detached and marked dying; Purge() frees them.
+void Animation::Scheduler::StepAll(int64 now)
+{
+    for (int i = 0; i < active.GetCount(); ++i) {
+        State* s = active[i];
+        if (!s || s->dying || s->linked)
+            continue;
+        if (s->spec->max_hz > 0 && !s->paused) {
+            if (now < s->due_ms)
+                continue;            // rate group not due this frame
+            s->ScheduleNext(now);
+        }
+        StepOne(s, now);
+    }
+}
+
+// Step one state; a run that ends is detached and marked dying. Returns
+// false if it ended. Caller sets 'sweeping'.
+bool Animation::Scheduler::StepOne(State* s, int64 now)
+{
+    bool cont = true;
+    try {
+        cont = s->Step(now);
+    } catch (...) {
+        Cerr() << "Exception in Animation::State::Step\n";
+        cont = false;
+    }
+
+    if (!cont) {
+        Retire(s, s->owner ? 1.0 : 0.0); // natural finish / owner died
+        s->dying = true;
+    }
+    return cont;
+}
+
+// Immediate first frame of a just-added run, at its start time (also the
+// step of a linked run whose source moved). Inside a frame the sweep's
+// Purge() reaps it; otherwise a run that already ended (tick returned
+// false, zero-length run) is reaped here.
+void Animation::Scheduler::StepFirst(State* s)
+{
+    if (s->spec->max_hz > 0)
+        s->ScheduleNext(s->start_ms);
+    if (sweeping) {
+        StepOne(s, s->start_ms);
+        return;
+    }
+    sweeping = true;
+    bool cont = StepOne(s, s->start_ms);
+    sweeping = false;
+    if (!cont) {
+        Purge();
+        MaybeStopIfAllPaused();
+    }
+}
+
+// Frame hooks see the frame timestamp the runs got. Hooks subscribed during
+// the sweep start with the next frame.
+void Animation::Scheduler::StepHooks(int64 now)
+{
+    const int n = hooks.GetCount();
+    for (int i = 0; i < n && i < hooks.GetCount(); ++i) {
+        FrameHook& h = hooks[i];
+        if (h.dying)
+            continue;
+        if (!h.owner) {           // owner died
+            h.dying = true;
+            continue;
+        }
+        const double dt = double(max<int64>(0, now - h.last)); // 0 across a backward seek
+        h.last = now;
+        bool cont = true;
+        try {
+            cont = h.fn(now, dt);
+        } catch (...) {
+            Cerr() << "Exception in Animation frame hook\n";
+            cont = false;
+        }
+        if (!cont && i < hooks.GetCount())
+            hooks[i].dying = true;
+    }
+}
+
+bool Animation::Scheduler::HasLiveHooks() const
+{
+    for (const FrameHook& h : hooks)
+        if (!h.dying && h.owner)
+            return true;
+    return false;
+}
+
+int Animation::Scheduler::GetFrameHookCount() const
+{
+    int n = 0;
+    for (const FrameHook& h : hooks)
+        if (!h.dying) ++n;
+    return n;
+}
+
+// OnFrame(): subscribe; dt of the first call counts from now.
+int Animation::Scheduler::OnFrame(Ctrl& owner, Function<bool(int64, double)> fn)
+{
+    FrameHook& h = hooks.Add();
+    h.id    = ++hook_seq;
+    h.owner = &owner;
+    h.fn    = pick(fn);
+    h.last  = FrameTime();
+    Start();
+    return h.id;
+}
+
+// CancelFrame(): unsubscribe (deferred while a frame is running).
+void Animation::Scheduler::CancelFrame(int id)
+{
+    for (int i = 0; i < hooks.GetCount(); ++i)
+        if (hooks[i].id == id && !hooks[i].dying) {
+            hooks[i].dying = true;
+            if (!sweeping) {
+                hooks.Remove(i);
+                MaybeStopIfAllPaused();
+            }
+            return;
+        }
+}
+
+// Delete dying states after iteration (keeps iteration stable), preserving order.
+void Animation::Scheduler::Purge()
+{
+    for (int i = hooks.GetCount() - 1; i >= 0; --i)
+        if (hooks[i].dying)
+            hooks.Remove(i);
+
+    int j = 0;
+    for (int i = 0; i < active.GetCount(); ++i) {
+        State* s = active[i];
+        if (s && !s->dying)
+            active[j++] = s;
+        else
+            DeleteState(s);
+    }
+    active.Trim(j);
+}
+
+// One display frame at wall time 'now'. A slaved clock is corrected first
+// (a seek fires on_seek before any run steps). In fixed-step mode the
+// simulation catches up in whole steps and render hooks receive the
+// leftover fraction.
+void Animation::Scheduler::RunFrame(int64 now)
+{
+    UpdateCulling(now);
+    now = Slave(now);
+    sweeping   = true;
+    frame_sync = true;
+
+    if (fixed_hz > 0) {
+        const double step = 1000.0 / fixed_hz;
+        sim_acc += double(max<int64>(0, now - sim_wall));
+        sim_wall = now;
+        int n = 0;
+        while (sim_acc >= step && n < fixed_max) {
+            sim_acc -= step;
+            sim_ms  += step;
+            frame_now = int64(sim_ms);
+            StepAll(frame_now);
+            ++n;
+        }
+        if (sim_acc >= step)
+            sim_acc = fmod(sim_acc, step);  // drop the backlog; sim clock slips
+        frame_now = int64(sim_ms);
+
+        const double alpha = sim_acc / step;
+        for (int i = 0; i < active.GetCount(); ++i) {
+            State* s = active[i];
+            if (s && !s->dying && !s->paused && !s->culled && s->spec->on_render)
+                s->spec->on_render(alpha);
+        }
+    }
+    else {
+        frame_now = now;
+        StepAll(now);
+    }
+    StepHooks(frame_now);
+
+    sweeping = false;
+    Purge();
+
+    MaybeStopIfAllPaused(); // idle → grace countdown / disarm
+}
+
+// Sleep until the earliest due run: step_ms if any run or frame hook updates
+// every frame (or we are idling / in fixed-step mode), else the nearest rate
+// group.
+int Animation::Scheduler::WakeDelay(int64 now) const
+{
+    if (fixed_hz > 0 || idle_since >= 0 || HasLiveHooks())
+        return step_ms;
+    int64 wake = -1;
+    for (State* s : active) {
+        if (!s || s->dying || s->paused || s->linked)
+            continue;
+        if (s->spec->max_hz <= 0)
+            return step_ms;
+        if (wake < 0 || s->due_ms < wake)
+            wake = s->due_ms;
     }
-    int GetFPSInternal() const { return fps; }
+    return wake < 0 ? step_ms : (int)clamp<int64>(wake - now, step_ms, 1000);
+}
 
-    // Stop timer if there is nothing to advance (all paused or dying).
-    void MaybeStopIfAllPaused() {
-        for (Animation::State* s : active)
-            if (s && !s->paused && !s->dying)
-                return; // at least one needs ticking
-        Stop();
+int Animation::Scheduler::GetWakeDelay()
+{
+    return WakeDelay(FrameTime());
+}
+
+// Timer-driven frame updates. An idle timer keeps ticking (cheap empty
+// frames) until RunFrame() ends the grace period.
+void Animation::Scheduler::TickTimer(int current_id)
+{
+    if (current_id != timer_id || !running) return;
+    int64 now = Wall();
+    int64 t0  = usecs();
+    RecordFrame(t0);
+    RunFrame(now);
+    Govern((usecs() - t0) / 1000.0, now - armed_due);
+    if (current_id == timer_id && running) {
+        int delay = WakeDelay(frame_now);   // due times are on the run clock
+        armed_due = now + delay;
+        sleeping  = delay > step_ms;
+        stats_expect_us = delay * 1000;
+        ticker.Set(delay, callback1(this, &Scheduler::TickTimer, current_id));
     }
+}
 
-    // Ensure timer runs if there is something to advance.
-    void EnsureRunningIfAnyUnpaused() {
-        for (Animation::State* s : active)
-            if (s && !s->paused && !s->dying) { Start(); return; }
-        // all paused: nothing to do
+// Frame spacing: deviation of each interval from the one that was asked for.
+void Animation::Scheduler::RecordFrame(int64 stamp_us)
+{
+    if (stats_last_us > 0) {
+        int64 dev = stamp_us - stats_last_us - stats_expect_us;
+        if (dev < 0) dev = -dev;
+        FrameStats& st = stats;
+        st.hist[(int)min<int64>(dev / FrameStats::BIN_US, FrameStats::BINS - 1)]++;
+        st.max_us = max(st.max_us, dev);
+        ++st.frames;
+        st.mean_us += (dev - st.mean_us) / st.frames;
     }
+    stats_last_us = stamp_us;
+}
 
-    // Destroy a state if present.
-    void DeleteState(Animation::State* s) { if (s) delete s; }
+void Animation::Scheduler::ResetFrameStats()
+{
+    stats = FrameStats();
+    stats_last_us = 0;
+}
 
-    // Finalize: stop and purge all animations; detach back-pointers first.
-    void Finalize() {
-        running = false;
-        ++timer_id;
-        ticker.Kill();
+int Animation::Scheduler::FrameStats::Percentile(double p) const
+{
+    int64 want = max<int64>(1, int64(ceil(p * frames)));
+    int64 seen = 0;
+    for (int i = 0; i < BINS; ++i)
+        if ((seen += hist[i]) >= want)
+            return i == BINS - 1 ? (int)max_us : (i + 1) * BIN_US;
+    return 0;
+}
 
-        // Phase 1: break Animation ↔ State links so Animations don't keep live_.
-        for (Animation::State* s : active) {
-            if (!s) continue;
-            if (s->anim) {
-                Animation* a = s->anim;
-                double snap = a->Progress();          // snapshot forward progress
-                a->_OnStateRemovedCancel(snap);       // sets live_ = nullptr; cache
-                s->anim = nullptr;                    // break back-pointer
-            }
+String Animation::Scheduler::FrameStats::ToString() const
+{
+    String r = Format("%d frames, mean %d us, p50 <= %d us, p99 <= %d us, max %d us",
+                      frames, int(mean_us + 0.5), Percentile(0.5), Percentile(0.99), max_us);
+    for (int i = 0; i < BINS; ++i)
+        if (hist[i]) {
+            if (i == BINS - 1)
+                r += Format("\n  %d+ us: %d", i * BIN_US, hist[i]);
+            else
+                r += Format("\n  %d..%d us: %d", i * BIN_US, (i + 1) * BIN_US, hist[i]);
         }
-        // Phase 2: delete states and clear.
-        for (Animation::State* s : active)
-            DeleteState(s);
-        active.Clear();
-        manual_last_now = 0;
-    }
+    return r;
+}
 
-    // Start/stop timer loop.
-    void Start() {
-        if (running) return;
-        running = true;
-        int current_id = ++timer_id;
-        ticker.Set(step_ms, callback1(this, &Scheduler::TickTimer, current_id));
-    }
-    void Stop() {
-        if (!running) return;
-        running = false;
-        ++timer_id; // invalidate queued ticks
-        ticker.Kill();
+
+// SetFrameSource(): swap the frame driver; a running timer continues on the new one.
+bool Animation::Scheduler::SetFrameSource(int src)
+{
+    bool was = running;
+    Stop();
+    source.Clear();
+    frame_source = FRAME_TIMER;
+    if (src == FRAME_TIMERFD) {
+        source.Create(*this);
+        if (source->Open())
+            frame_source = FRAME_TIMERFD;
+        else
+            source.Clear();
     }
+    if (was)
+        Start();
+    return frame_source == src;
+}
+
+// One manual tick for tests; clamps dt if requested. No-op while suspended.
+void Animation::Scheduler::TickManualOnce(int max_ms_per_tick)
+{
+    if (suspended) return;
+    int64 clock_now = Wall();
+    if (manual_last_now == 0)
+        manual_last_now = clock_now;
+
+    int64 dt = clock_now - manual_last_now;
+    if (max_ms_per_tick > 0 && dt > max_ms_per_tick)
+        dt = max_ms_per_tick;
+    if (dt < 0) dt = 0; // guard against clock skew
+
+    manual_last_now += dt;
+    int64 t0 = usecs();
+    RunFrame(manual_last_now);
+    Govern((usecs() - t0) / 1000.0, 0);
+}
+
+// Tick(): advance this scheduler by n frames; optionally clamp each dt.
+void Animation::Scheduler::Tick(int n, int max_ms_per_tick)
+{
+    for (int i = 0; i < n; ++i)
+        TickManualOnce(max_ms_per_tick);
+}
 
-    // Add/remove active states.
-    void Add(Animation::State* s) {
-        active.Add(s);
+// SetVirtualClock(): swap the time base under Wall() without a jump (the
+// offset goes into clock_skip, and into suspend_ms while suspended).
+void Animation::Scheduler::SetVirtualClock(bool b)
+{
+    if (b == virtual_clock) return;
+    const int64 from = Clock();
+    const bool  was  = running;
+    Stop();
+    virtual_clock = b;
+    virtual_ms    = from;
+    const int64 d = Clock() - from;
+    clock_skip += d;
+    if (suspended)
+        suspend_ms += d;
+    if (was)
         Start();
-    }
-    void Remove(Animation::State* st) {
-        if (!st) return;
-        if (sweeping) { // never mutate 'active' mid-iteration
-            st->dying = true;
-            return;
-        }
-        for (int i = 0; i < active.GetCount(); ++i) {
-            if (active[i] == st) {
-                DeleteState(active[i]);
-                active.Remove(i);
-                break;
-            }
-        }
-        if (active.IsEmpty())
-            Stop();
-    }
-
-    // Kill all animations for a given Ctrl or dead owners; Progress=0.0.
-    void KillFor(Ctrl* c) {
-        for (int i = active.GetCount() - 1; i >= 0; --i) {
-            Animation::State* s = active[i];
-            if (!s || !s->owner || s->owner == c) {
-                if (s && s->anim) {
-                    Animation* a = s->anim;
-                    a->_OnStateRemovedCancel(0.0); // clears a->live_, Progress=0
-                    s->anim = nullptr;
-                }
-                if (s) s->dying = true; // defer delete to next sweep
-            }
-        }
-        // Defer actual free to RunFrame(); avoids re-entrancy.
-    }
+}
 
-    // Advance all active animations to 'now'; sweep dead states after iteration.
-    void RunFrame(int64 now) {
-        sweeping = true;
-        Vector<int> to_remove;
+// AdvanceTime(): frames on the virtual clock, exactly like manual ticks.
+void Animation::Scheduler::AdvanceTime(int64 ms, int frame_ms)
+{
+    SetVirtualClock(true);
+    frame_ms = max(1, frame_ms);
+    while (ms > 0) {
+        const int64 d = min<int64>(ms, frame_ms);
+        virtual_ms += d;
+        ms -= d;
+        TickManualOnce(0);
+    }
+}
 
-        for (int i = 0; i < active.GetCount(); ++i) {
-            Animation::State* s = active[i];
-            bool cont = true;
-
-            if (!s || s->dying) {
-                cont = false;
-            } else {
-                try {
-                    cont = s->Step(now);
-                } catch (...) {
-                    Cerr() << "Exception in Animation::State::Step\n";
-                    cont = false;
-                }
-            }
+/*==================== Animation::State::Step ====================
+  Map the total run time to (leg, direction, in-leg progress) by division,
+  compute the eased value and invoke callbacks. Returns true to keep
+  scheduling. A frame may land any number of legs later; it resolves in O(1)
+  and keeps the phase (the overshoot past a boundary belongs to the next leg). */
+
+// Legs in the run: non-yoyo = loop_count, yoyo = 2 per forward+reverse
+// cycle with (loop_count + 1) / 2 cycles; at least one leg/cycle.
+int64 Animation::State::LegCount() const
+{
+    if (spec->loop_count < 0 || spec->kind != RUN_TWEEN)
+        return -1;
+    return spec->yoyo ? 2 * max(1, (spec->loop_count + 1) / 2)
+                     : max(1, spec->loop_count);
+}
 
-            if (!cont) {
-                if (s && s->anim) {
-                    Animation* a = s->anim;
-                    if (!s->owner) a->_OnStateRemovedCancel(0.0); // owner died → abort
-                    else           a->_OnStateRemovedFinish();    // natural finish
-                    s->anim = nullptr;
-                }
-                to_remove.Add(i);
-            }
-        }
+// Clock time at which the run ends (delay + all legs), accounting for pauses.
+int64 Animation::State::EndTime() const
+{
+    if (linked)
+        return -1;
+    if (spec->kind == RUN_DECAY)
+        return end_ms < 0 ? -1 : start_ms - elapsed_ms + spec->delay_ms + int64(ceil(end_ms));
+    int64 total = LegCount();
+    if (total < 0)
+        return -1;
+    return start_ms - elapsed_ms + spec->delay_ms + total * max(1, spec->duration_ms);
+}
 
-        sweeping = false;
+// Next step of a rate-capped run: the following multiple of its period, so
+// every run of the same rate lands on the same frames. Never skip the end.
+void Animation::State::ScheduleNext(int64 now)
+{
+    const int64 period = max(1, 1000 / spec->max_hz);
+    due_ms = (now / period + 1) * period;
+    int64 end = EndTime();
+    if (end >= 0 && end > now && end < due_ms)
+        due_ms = end;
+}
 
-        // Delete after iteration to keep iteration stable.
-        for (int k = to_remove.GetCount() - 1; k >= 0; --k) {
-            DeleteState(active[to_remove[k]]);
-            active.Remove(to_remove[k]);
-        }
+// Normalized time progress (independent of easing), pauses accounted for.
+// Spring runs report the part of the current segment's distance covered.
+double Animation::State::Progress(int64 now) const
+{
+    if (linked)
+        return spec->link ? spec->link->GetProgress() : 0.0;
+    const int64 run = max<int64>(0, RunTime(now));
+    if (spec->kind != RUN_TWEEN) {
+        if (!seeded)
+            return 0;
+        double x, v;
+        Sample(run, x, v);
+        const double span = fabs(x0 - target);
+        return span > 0 ? clamp(1 - fabs(x - target) / span, 0.0, 1.0) : 1.0;
+    }
+    int64 cur;
+    return LegProgress(run, cur);
+}
 
-        if (active.IsEmpty())
-            Stop();
+// Same leg division as StepTween(): past the final leg, the end of that leg.
+double Animation::State::LegProgress(int64 t, int64& cur) const
+{
+    const int64 dur   = max(1, spec->duration_ms);
+    const int64 total = LegCount();
+    cur = t / dur;
+    if (total >= 0 && cur >= total) {
+        cur = total - 1;
+        return 1.0;
     }
+    return double(t - cur * dur) / dur;
+}
 
-    // Timer-driven frame updates.
-    void TickTimer(int current_id) {
-        if (current_id != timer_id || !running) return;
-        RunFrame(msecs());
-        if (!active.IsEmpty())
-            ticker.Set(step_ms, callback1(this, &Scheduler::TickTimer, current_id));
+int64 Animation::State::RunTime(int64 now) const
+{
+    return elapsed_ms + (paused ? 0 : now - start_ms) - spec->delay_ms;
+}
+
+double Animation::State::EndValue() const
+{
+    if (spec->kind == RUN_SPRING)
+        return seeded ? target : spec->to;
+    if (spec->kind == RUN_DECAY)
+        return seeded ? target : DecayEnd(spec->from, spec->velocity, spec->friction,
+                                          spec->bound_lo, spec->bound_hi);
+    return reverse ? 0.0 : 1.0;
+}
+
+/*==================== Spring and decay runs ====================
+  m x'' + c x' + k (x - target) = 0 solved in closed form for the segment
+  that starts at run time seg_ms with (x0, v0): under-, critically or
+  over-damped. A decay segment coasts: v = v0 e^(-f t), x = x0 + v0 / f *
+  (1 - e^(-f t)), resting at x0 + v0 / f; its end time and the time it
+  crosses a bound follow from the same formula. A frame evaluates the
+  segment at its run time, so the motion does not depend on the frame rate
+  and a stalled frame lands on the exact position. */
+
+void Animation::State::Seed()
+{
+    x0       = spec->from;
+    v0       = spec->velocity;
+    target   = spec->to;
+    seg_ms   = 0;
+    seeded   = true;
+    settling = false;
+    cross_ms = end_ms = -1;
+    if (spec->kind != RUN_DECAY)
+        return;
+    const double lo = spec->bound_lo, hi = spec->bound_hi, f = max(spec->friction, 1e-9);
+    target = DecayEnd(x0, v0, f, lo, hi);
+    if (x0 < lo || x0 > hi) {     // starts out of bounds (overscrolled): spring back
+        settling = true;
+        return;
     }
+    const double reach = v0 / f;  // distance to the resting point
+    if (x0 + reach > hi || x0 + reach < lo)
+        cross_ms = -1000 * log(1 - (target - x0) / reach) / f;
+    else
+        end_ms = fabs(reach) > spec->rest ? 1000 * log(fabs(reach) / spec->rest) / f : 0;
+}
 
-    // One manual tick for tests; clamps dt if requested.
-    void TickManualOnce(int max_ms_per_tick) {
-        int64 wall_now = msecs();
-        if (manual_last_now == 0)
-            manual_last_now = wall_now;
+// Decay reached the bound at cross_ms: spring from there with its velocity.
+void Animation::State::Settle()
+{
+    v0       = v0 * exp(-max(spec->friction, 1e-9) * (cross_ms - seg_ms) / 1000);
+    x0       = target;
+    seg_ms   = cross_ms;
+    cross_ms = -1;
+    settling = true;
+}
 
-        int64 dt = wall_now - manual_last_now;
-        if (max_ms_per_tick > 0 && dt > max_ms_per_tick)
-            dt = max_ms_per_tick;
-        if (dt < 0) dt = 0; // guard against clock skew
+double Animation::DecayEnd(double from, double velocity, double friction, double lo, double hi)
+{
+    if (from < lo || from > hi)
+        return clamp(from, lo, hi);
+    return clamp(from + velocity / max(friction, 1e-9), lo, hi);
+}
 
-        manual_last_now += dt;
-        RunFrame(manual_last_now);
+void Animation::State::Sample(int64 t_ms, double& x, double& v) const
+{
+    const double t  = max(0.0, t_ms - seg_ms) / 1000.0;
+    if (spec->kind == RUN_DECAY && !settling) {
+        const double f = max(spec->friction, 1e-9), e = exp(-f * t);
+        x = x0 + v0 / f * (1 - e);
+        v = v0 * e;
+        return;
     }
-};
+    const double m  = max(spec->mass, 1e-9);
+    const double k  = max(spec->stiffness, 1e-9);
+    const double w0 = sqrt(k / m);
+    const double z  = spec->damping / (2 * sqrt(k * m));
+    const double y0 = x0 - target;
+    double y, dy;
+    if (z < 1 - 1e-6) {           // underdamped: decaying oscillation
+        const double a  = z * w0, wd = w0 * sqrt(1 - z * z);
+        const double b  = (v0 + a * y0) / wd;
+        const double e  = exp(-a * t), c = cos(wd * t), sn = sin(wd * t);
+        y  = e * (y0 * c + b * sn);
+        dy = e * ((b * wd - a * y0) * c - (y0 * wd + a * b) * sn);
+    }
+    else if (z <= 1 + 1e-6) {     // critically damped (SmoothDamp)
+        const double e = exp(-w0 * t), b = v0 + w0 * y0;
+        y  = e * (y0 + b * t);
+        dy = e * (v0 - w0 * b * t);
+    }
+    else {                        // overdamped: two decaying modes
+        const double q  = sqrt(z * z - 1);
+        const double r1 = -w0 * (z - q), r2 = -w0 * (z + q);
+        const double c1 = (v0 - r2 * y0) / (r1 - r2), c2 = y0 - c1;
+        const double e1 = exp(r1 * t), e2 = exp(r2 * t);
+        y  = c1 * e1 + c2 * e2;
+        dy = c1 * r1 * e1 + c2 * r2 * e2;
+    }
+    x = target + y;
+    v = dy;
+}
 
-} // namespace
+// New target from the current position and velocity (the follower case).
+void Animation::State::SetTarget(double to, int64 now)
+{
+    if (!seeded)
+        Seed();
+    const int64 t = max<int64>(0, RunTime(now));
+    Sample(t, x0, v0);
+    target = to;
+    seg_ms = double(t);
+}
+
+bool Animation::State::StepSpring(int64 t)
+{
+    if (!seeded)
+        Seed();
+    if (cross_ms >= 0 && t >= cross_ms)
+        Settle();
+    double x, v;
+    Sample(t, x, v);
+    bool done;
+    if (spec->kind == RUN_DECAY && !settling)  // coasting: distance left to rest (|v| / f)
+        done = cross_ms < 0 && fabs(x - target) <= spec->rest;
+    else {
+        const double w0 = sqrt(max(spec->stiffness, 1e-9) / max(spec->mass, 1e-9));
+        done = fabs(x - target) + fabs(v) / w0 < spec->rest;
+    }
+    if (done)
+        x = target;
+    if (!culled || done) {
+        if (spec->on_update) spec->on_update(x);
+        if (!Tick(x))
+            return false;
+    }
+    if (done) {
+        if (spec->on_finish) spec->on_finish();
+        return false;
+    }
+    return true;
+}
 
-/*==================== Animation::State::Step ====================
-  Advance time within the current leg, compute eased value, invoke callbacks,
-  and handle loop/yoyo bookkeeping. Returns true to keep scheduling. */
 bool Animation::State::Step(int64 now)
 {
     if (!owner) return false;   // owner died
     if (paused) return true;    // stay scheduled, do not advance
 
-    const int64 local = now - start_ms + elapsed_ms;
-    if (local < spec.delay_ms)
+    if (linked)
+        return StepTween(LinkTime(), false);
+
+    const int64 local = RunTime(now);
+    if (local < 0)
         return true;            // still in delay window
+    if (spec->kind != RUN_TWEEN)
+        return StepSpring(local);
+    return StepTween(double(local), true);
+}
+
+// Linked run: the source position over the whole timeline (delay + legs; an
+// infinite loop counts one leg). Before the delay ends it shows t = 0.
+double Animation::State::LinkTime() const
+{
+    const double dur = max(1, spec->duration_ms);
+    const double p   = spec->link ? spec->link->GetProgress() : 0.0;
+    return max(0.0, p * (spec->delay_ms + max<int64>(1, LegCount()) * dur) - spec->delay_ms);
+}
 
-    const int dur = max(1, spec.duration_ms);
-    double leg_progress = double(local - spec.delay_ms) / dur;
-    leg_progress = clamp(leg_progress, 0.0, 1.0);
+// Tween frame at run time t (ms after the delay). At the end of the last leg
+// a clocked run finishes; a linked one ('finish' false) holds the end value.
+bool Animation::State::StepTween(double t_ms, bool finish)
+{
+    const int64 dur   = max(1, spec->duration_ms);
+    const int64 total = linked ? max<int64>(1, LegCount()) : LegCount();
+    int64  cur = int64(t_ms / dur);
+    double leg_progress = (t_ms - double(cur * dur)) / dur;
+    const bool end = total >= 0 && cur >= total;
+    if (end) {                  // clamp to the end of the final leg
+        cur = total - 1;
+        leg_progress = 1.0;
+    }
+    const bool done = end && finish;
 
-    // Adjust for yoyo direction.
+    // Direction of the current leg (yoyo: odd legs run backwards).
+    reverse = spec->yoyo && (cur & 1);
     double t = reverse ? (1.0 - leg_progress) : leg_progress;
 
-    // Apply easing.
-    const double e = spec.easing ? spec.easing(t) : t;
-
-    // Callbacks.
-    if (spec.on_update) spec.on_update(e);
-    if (spec.tick && !spec.tick(e))
-        return false;           // user requested stop → treated as finish/cancel
-
-    // Leg finished?
-    if (leg_progress >= 1.0) {
-        if (spec.yoyo) {
-            reverse = !reverse;
-            if (!reverse) { // finished a forward+reverse cycle
-                if (spec.loop_count >= 0 && --cycles <= 0) {
-                    if (spec.on_finish) spec.on_finish();
-                    return false;       // natural finish
-                }
-            }
-            start_ms = now;             // next leg
-            elapsed_ms = 0;
-        } else {
-            if (spec.loop_count >= 0 && --cycles <= 0) {
-                if (spec.on_finish) spec.on_finish();
-                return false;           // natural finish
-            }
-            start_ms = now;             // next loop
-            elapsed_ms = 0;
-        }
+    // Leg boundary crossed since the last frame (possibly several). A linked
+    // run moved back by its input does not report legs on the way back.
+    if (cur > leg) {
+        int skipped = (int)min<int64>(cur - leg - 1, INT_MAX);
+        leg = cur;
+        if (spec->on_leg) spec->on_leg(skipped);
+    }
+    else if (cur < leg)
+        leg = cur;
+
+    // Culled runs only deliver the value that ends the run.
+    if (!culled || done) {
+        const double e = spec->easing ? spec->easing(t) : t;
+        if (spec->on_update) spec->on_update(e);
+        if (!Tick(e))
+            return false;       // user requested stop → treated as finish/cancel
+    }
+
+    if (done) {
+        if (spec->on_finish) spec->on_finish();
+        return false;           // natural finish
     }
     return true;
 }
 
 /*==================== Animation implementation ====================*/
 
-// Construct an Animation bound to 'owner'. Initializes empty staging config.
+// Default config shared by every Animation until a setter writes (one
+// process-wide copy; constructing or resetting an Animation allocates nothing).
+static const Animation::SpecRef& DefaultSpec()
+{
+    static Animation::SpecRef spec = Animation::SpecRef::Make(Animation::Staging());
+    return spec;
+}
+
+// Construct an Animation bound to 'owner'. Staging starts as the shared default.
 Animation::Animation(Ctrl& owner)
     : owner_(&owner)
+    , staging_(DefaultSpec())
+{
+}
+
+// Same, but runs are driven by 'sched' instead of Scheduler::Default().
+Animation::Animation(Ctrl& owner, Scheduler& sched)
+    : Animation(owner)
 {
-    staging_box_.Create();
-    staging_ = ~staging_box_;
+    sched_ = &sched;
 }
 
 // Destructor: detach safely if a run is still live.
@@ -293,8 +1729,39 @@ Animation::Animation(Ctrl& owner)
 // This is a *silent* detach (no on_cancel); last_spec_ remains intact for Replay().
 Animation::~Animation()
 {
-    if (live_)
-        _Unschedule(false); // silent
+    _Unschedule(false); // silent
+}
+
+// Moving takes over the run: its slot now notifies the new object.
+Animation::Animation(Animation&& b)
+    : owner_(b.owner_)
+    , sched_(b.sched_)
+    , staging_(pick(b.staging_))
+    , live_(b.live_)
+    , progress_cache_(b.progress_cache_)
+    , last_spec_(pick(b.last_spec_))
+{
+    b.live_ = AnimHandle();
+    if (RunSlot* r = FindSlot(live_.id))
+        r->anim = this;
+}
+
+// Move assignment silently drops this object's own run first.
+Animation& Animation::operator=(Animation&& b)
+{
+    if (this == &b)
+        return *this;
+    _Unschedule(false);
+    owner_          = b.owner_;
+    sched_          = b.sched_;
+    staging_        = pick(b.staging_);
+    live_           = b.live_;
+    progress_cache_ = b.progress_cache_;
+    last_spec_      = pick(b.last_spec_);
+    b.live_ = AnimHandle();
+    if (RunSlot* r = FindSlot(live_.id))
+        r->anim = this;
+    return *this;
 }
 
 
@@ -302,64 +1769,93 @@ Animation::~Animation()
 
 /*---------------- Staging setters (lazily re-prime if null) ----------------*/
 
-Animation& Animation::Duration(int ms)                    { EnsureStaging_(); RET(staging_->duration_ms = ms); }
-Animation& Animation::Ease(const Easing::Fn& fn)          { EnsureStaging_(); RET(staging_->easing = fn); }
-Animation& Animation::Ease(Easing::Fn&& fn)               { EnsureStaging_(); RET(staging_->easing = pick(fn)); }
-Animation& Animation::Loop(int n)                         { EnsureStaging_(); RET(staging_->loop_count = n); }
-Animation& Animation::Yoyo(bool b)                        { EnsureStaging_(); RET(staging_->yoyo = b); }
-Animation& Animation::Delay(int ms)                       { EnsureStaging_(); RET(staging_->delay_ms = ms); }
+Animation& Animation::Duration(int ms)                    { RET(EnsureStaging_().duration_ms = ms); }
+Animation& Animation::Ease(const Easing::Fn& fn)          { RET(EnsureStaging_().easing = fn); }
+Animation& Animation::Ease(Easing::Fn&& fn)               { RET(EnsureStaging_().easing = pick(fn)); }
+Animation& Animation::Loop(int n)                         { RET(EnsureStaging_().loop_count = n); }
+Animation& Animation::Yoyo(bool b)                        { RET(EnsureStaging_().yoyo = b); }
+Animation& Animation::Delay(int ms)                       { RET(EnsureStaging_().delay_ms = ms); }
+Animation& Animation::Priority(int p)                     { RET(EnsureStaging_().priority = p); }
+Animation& Animation::MaxRate(int hz)                     { RET(EnsureStaging_().max_hz = max(0, hz)); }
+Animation& Animation::Immediate(bool b)                   { RET(EnsureStaging_().immediate = b); }
+
+Animation& Animation::Range(double from, double to)       { Staging& w = EnsureStaging_(); w.from = from; RET(w.to = to); }
+Animation& Animation::Velocity(double v)                  { RET(EnsureStaging_().velocity = v); }
+Animation& Animation::Rest(double amplitude)              { RET(EnsureStaging_().rest = max(1e-9, amplitude)); }
+
+Animation& Animation::Spring(double stiffness, double damping, double mass)
+{
+    Staging& w = EnsureStaging_();
+    if (w.kind == RUN_TWEEN)      // a decay run keeps its kind: this is its bound spring
+        w.kind  = RUN_SPRING;
+    w.stiffness = max(1e-9, stiffness);
+    w.damping   = max(0.0, damping);
+    RET(w.mass  = max(1e-9, mass));
+}
+
+Animation& Animation::Decay(double from, double velocity, double friction)
+{
+    Staging& w = EnsureStaging_();
+    w.kind     = RUN_DECAY;
+    w.from     = from;
+    w.velocity = velocity;
+    RET(w.friction = max(1e-9, friction));
+}
+
+Animation& Animation::Bounds(double lo, double hi)        { Staging& w = EnsureStaging_(); w.bound_lo = min(lo, hi); RET(w.bound_hi = max(lo, hi)); }
+Animation& Animation::Link(ProgressSource& src)           { RET(EnsureStaging_().link = &src); }
 
-Animation& Animation::OnStart(const Event<>& cb)         { EnsureStaging_(); RET(staging_->on_start  = cb); }
-Animation& Animation::OnStart(Event<>&& cb)              { EnsureStaging_(); RET(staging_->on_start  = pick(cb)); }
+// SmoothDamp: critically damped, w0 = 2 / smooth time (the usual follower
+// parametrization: the lag behind a moving target is about smooth_ms).
+Animation& Animation::SmoothDamp(int smooth_ms)
+{
+    const double w0 = 2000.0 / max(1, smooth_ms);
+    return Spring(w0 * w0, 2 * w0, 1);
+}
+
+Animation& Animation::OnStart(const SmallEvent<>& cb)         { RET(EnsureStaging_().on_start  = cb); }
+Animation& Animation::OnStart(SmallEvent<>&& cb)              { RET(EnsureStaging_().on_start  = pick(cb)); }
+
+Animation& Animation::OnFinish(const SmallEvent<>& cb)        { RET(EnsureStaging_().on_finish = cb); }
+Animation& Animation::OnFinish(SmallEvent<>&& cb)             { RET(EnsureStaging_().on_finish = pick(cb)); }
 
-Animation& Animation::OnFinish(const Event<>& cb)        { EnsureStaging_(); RET(staging_->on_finish = cb); }
-Animation& Animation::OnFinish(Event<>&& cb)             { EnsureStaging_(); RET(staging_->on_finish = pick(cb)); }
+Animation& Animation::OnCancel(const SmallEvent<>& cb)        { RET(EnsureStaging_().on_cancel = cb); }
+Animation& Animation::OnCancel(SmallEvent<>&& cb)             { RET(EnsureStaging_().on_cancel = pick(cb)); }
 
-Animation& Animation::OnCancel(const Event<>& cb)        { EnsureStaging_(); RET(staging_->on_cancel = cb); }
-Animation& Animation::OnCancel(Event<>&& cb)             { EnsureStaging_(); RET(staging_->on_cancel = pick(cb)); }
+Animation& Animation::OnUpdate(const SmallEvent<double>& c)   { RET(EnsureStaging_().on_update = c); }
+Animation& Animation::OnUpdate(SmallEvent<double>&& c)        { RET(EnsureStaging_().on_update = pick(c)); }
 
-Animation& Animation::OnUpdate(const Event<double>& c)   { EnsureStaging_(); RET(staging_->on_update = c); }
-Animation& Animation::OnUpdate(Event<double>&& c)        { EnsureStaging_(); RET(staging_->on_update = pick(c)); }
+Animation& Animation::OnLeg(const SmallEvent<int>& c)         { RET(EnsureStaging_().on_leg = c); }
+Animation& Animation::OnLeg(SmallEvent<int>&& c)              { RET(EnsureStaging_().on_leg = pick(c)); }
 
-Animation& Animation::operator()(const Function<bool(double)>& f) { EnsureStaging_(); RET(staging_->tick = f); }
-Animation& Animation::operator()(Function<bool(double)>&& f)      { EnsureStaging_(); RET(staging_->tick = pick(f)); }
+Animation& Animation::OnRender(const SmallEvent<double>& c)   { RET(EnsureStaging_().on_render = c); }
+Animation& Animation::OnRender(SmallEvent<double>&& c)        { RET(EnsureStaging_().on_render = pick(c)); }
+
+Animation& Animation::operator()(const SmallFunction<bool(double)>& f) { RET(EnsureStaging_().tick = f); }
+Animation& Animation::operator()(SmallFunction<bool(double)>&& f)      { RET(EnsureStaging_().tick = pick(f)); }
 
 #undef RET
 
 /*---------------- Control methods ----------------*/
 
 // _Unschedule(): common detach path used by ~Animation/Cancel/Reset/Replay.
-// - Detaches from the live State and removes it from the scheduler safely.
+// - Removes the live run from its scheduler safely (no-op if dead).
 // - If fire_cancel==true, invokes on_cancel on the current spec.
 // - Always snapshots forward time progress into Progress() cache.
 // - Keeps last_spec_ intact for future Replay().
 void Animation::_Unschedule(bool fire_cancel)
 {
-    if (!live_)
-        return;
-
-    if (fire_cancel && live_->spec.on_cancel)
-        live_->spec.on_cancel();
-
-    const double p = Progress(); // forward-time snapshot for caching
-
-    Animation::State* st = live_;
-    live_ = nullptr;            // detach first (avoid re-entrancy surprises)
-    if (st->anim) st->anim = nullptr;
-
-    Scheduler::Inst().Remove(st); // deferred-safe removal via scheduler
-    _OnStateRemovedCancel(p);     // Progress() cache ← snapshot
+    live_.Cancel(fire_cancel);
 }
 
 
-// EnsureStaging_(): lazily create a fresh staging config if missing.
+// EnsureStaging_(): lazily re-prime staging (default config) if missing.
 // Needed after Play()/Cancel()/Stop() so setters always have a target.
-void Animation::EnsureStaging_() {
-    if (staging_)
-        return;
-    staging_box_.Create();
-    staging_ = ~staging_box_;
-    *staging_ = Staging(); // default config
+// Write() clones the staging while it is shared (the default spec included).
+Animation::Staging& Animation::EnsureStaging_() {
+    if (!staging_)
+        staging_ = DefaultSpec();
+    return staging_.Write();
 }
 
 // Reset(): silent abort + prime a fresh staging + Progress() ← 0.
@@ -367,7 +1863,7 @@ void Animation::EnsureStaging_() {
 void Animation::Reset()
 {
     _Unschedule(false); // silent (no on_cancel)
-    EnsureStaging_();   // user can immediately reconfigure
+    staging_ = DefaultSpec(); // user can immediately reconfigure
     progress_cache_ = 0.0;
 }
 
@@ -378,37 +1874,20 @@ void Animation::Reset()
 // - Else → no-op (we never run with accidental defaults).
 void Animation::Play()
 {
-    // If there is no fresh staging, try to reuse the last committed spec.
-    if (!staging_) {
-        if (!have_last_spec_)
+    // If there is no fresh staging, reuse the last committed spec (shared).
+    SpecRef spec = pick(staging_);    // consume staging
+    if (!spec) {
+        if (!last_spec_)
             return; // nothing to run yet
-        staging_box_.Create();
-        staging_ = ~staging_box_;
-        *staging_ = *~last_spec_box_; // copy the cached spec back to staging
+        spec = last_spec_;
     }
 
-    // Build a live State from the staged config.
-    live_ = new State;
-    live_->anim  = this;
-    live_->owner = owner_;
-    live_->spec  = pick(*staging_);   // consume staging (move/pick)
-    staging_ = nullptr;               // staging consumed
-
-    // Cache the just-committed spec so Replay() can re-run it later.
-    last_spec_box_.Create();
-    *~last_spec_box_ = live_->spec;
-    have_last_spec_  = true;
+    // Share the just-committed spec so Replay() can re-run it later.
+    last_spec_ = spec;
 
-    // Initialize runtime bookkeeping and schedule.
-     progress_cache_ = 0.0;
-    live_->start_ms = msecs();
-    live_->cycles   = (live_->spec.loop_count < 0)
-                    ? INT_MAX
-                    : (live_->spec.yoyo ? (live_->spec.loop_count + 1) / 2
-                                        :  live_->spec.loop_count);
-
-    if (live_->spec.on_start) live_->spec.on_start();
-    Scheduler::Inst().Add(live_);
+    // The scheduler builds and owns the run; we keep its handle.
+    progress_cache_ = 0.0;
+    GetScheduler().StartRun(owner_, pick(spec), this);
 }
 
 
@@ -416,25 +1895,14 @@ void Animation::Play()
 // Behavior:
 //  - If there is fresh staging (user just set setters), prefer that by calling Play().
 //    If a run is active, we silently interrupt it (no on_cancel) for smooth UX.
-//  - Else, if we have a cached last_spec_, rehydrate staging from it and Play().
+//  - Else, if we have a cached last_spec_, Play() shares it (no copy).
 //  - Else, no-op (there has never been a committed run).
 void Animation::Replay()
 {
-    if (staging_) {
-        if (live_) _Unschedule(false); // silent interrupt
-        Play();
-        return;
-    }
-
-    if (!have_last_spec_)
+    if (!staging_ && !last_spec_)
         return; // nothing to replay yet
 
-    if (live_) _Unschedule(false); // silent interrupt if currently running
-
-    // Rehydrate staging from the cached spec, then Play().
-    staging_box_.Create();
-    staging_ = ~staging_box_;
-    *staging_ = *~last_spec_box_;
+    _Unschedule(false); // silent interrupt if currently running
     Play();
 }
 
@@ -442,45 +1910,40 @@ void Animation::Replay()
 
 bool Animation::HasReplay() const
 {
-    return have_last_spec_;
+    return (bool)last_spec_;
+}
+
+// SetScheduler(): choose the scheduler for subsequent Play() calls.
+Animation& Animation::SetScheduler(Scheduler& s)
+{
+    sched_ = &s;
+    return *this;
+}
+
+// GetScheduler(): bound scheduler, falling back to the default one.
+Animation::Scheduler& Animation::GetScheduler() const
+{
+    return sched_ ? *sched_ : Scheduler::Default();
 }
 
 // Pause(): reversible freeze; accumulates elapsed_ms and stops time advancement.
 // Scheduler may stop ticking if everything is paused.
 void Animation::Pause()
 {
-    if (live_ && !live_->paused) {
-        live_->elapsed_ms += msecs() - live_->start_ms;
-        live_->paused = true;
-        Scheduler::Inst().MaybeStopIfAllPaused();
-    }
+    live_.Pause();
 }
 
 // Resume(): continue after Pause(); re-arms scheduler if needed.
 void Animation::Resume()
 {
-    if (live_ && live_->paused) {
-        live_->start_ms = msecs();
-        live_->paused = false;
-        Scheduler::Inst().EnsureRunningIfAnyUnpaused();
-    }
+    live_.Resume();
 }
 
 // Stop(): complete the animation immediately (Progress=1.0). Fires final tick
 // and on_finish, then unschedules and frees state.
 void Animation::Stop()
 {
-    if (!live_) return;
-
-    // Deliver final callbacks at boundary values.
-    if (live_->spec.tick)      live_->spec.tick(live_->reverse ? 0.0 : 1.0);
-    if (live_->spec.on_finish) live_->spec.on_finish();
-
-    Animation::State* st = live_;
-    _OnStateRemovedFinish();        // Progress ← 1.0; live_ ← nullptr
-
-    if (st->anim) st->anim = nullptr;
-    Scheduler::Inst().Remove(st);
+    live_.Stop(); // Progress ← 1.0; live_ dies
 }
 
 // Cancel(): abort the current run, fire on_cancel, keep last_spec_ for Replay().
@@ -494,72 +1957,293 @@ void Animation::Cancel()
 // IsPlaying(): true if a live state exists and is not paused.
 bool Animation::IsPlaying() const
 {
-    return live_ && !live_->paused;
+    return live_.IsPlaying();
 }
 
 // IsPaused(): true if a live state exists and is paused.
 bool Animation::IsPaused() const
 {
-    return live_ && live_->paused;
+    return live_.IsPaused();
 }
 
 // Progress(): normalized *time* progress in [0..1], independent of easing.
 // Uses cached value when no run is live.
 double Animation::Progress() const
 {
-    if (!live_) return progress_cache_;
-    int64 run = live_->elapsed_ms + (live_->paused ? 0 : (msecs() - live_->start_ms));
-    run = max<int64>(0, run - live_->spec.delay_ms);
-    return clamp(double(run) / max(1, live_->spec.duration_ms), 0.0, 1.0);
+    State* s = Scheduler::Resolve(live_);
+    return s ? s->Progress(s->sched->FrameTime()) : progress_cache_;
 }
 
 /*---------------- Manual ticking (tests/diagnostics) ----------------*/
 
-// Tick(): advance scheduler by n frames; optionally clamp each dt.
+// Tick(): advance the default scheduler by n frames; optionally clamp each dt.
 void Animation::Tick(int n, int max_ms_per_tick)
 {
-    if (n <= 0) return;
-    Scheduler& s = Scheduler::Inst();
-    for (int i = 0; i < n; ++i)
-        s.TickManualOnce(max_ms_per_tick);
+    Scheduler::Default().Tick(n, max_ms_per_tick);
+}
+
+// AdvanceTime(): simulated frames on the default scheduler's virtual clock.
+void Animation::AdvanceTime(int64 ms, int frame_ms)
+{
+    Scheduler::Default().AdvanceTime(ms, frame_ms);
+}
+
+void Animation::SetVirtualClock(bool b)
+{
+    Scheduler::Default().SetVirtualClock(b);
 }
 
 /*---------------- FPS control ----------------*/
 
-// SetFPS(): change target FPS; re-arms the timer loop if running.
+// SetCulling(): visibility culling on the default scheduler.
+void Animation::SetCulling(bool b, int check_ms) {
+    Scheduler::Default().SetCulling(b, check_ms);
+}
+
+// SetIdleGrace(): idle hysteresis on the default scheduler.
+void Animation::SetIdleGrace(int ms) {
+    Scheduler::Default().SetIdleGrace(ms);
+}
+
+// SetMotionMode(): process-wide; every scheduler re-steps (and snaps runs
+// in flight when switching to Instant).
+void Animation::SetMotionMode(int mode)
+{
+    mode = clamp(mode, (int)MOTION_FULL, (int)MOTION_INSTANT);
+    if (mode == MotionModeRef()) return;
+    MotionModeRef() = mode;
+    for (Scheduler* s : Schedulers())
+        s->ApplyMotionMode();
+}
+
+int Animation::GetMotionMode()
+{
+    return MotionModeRef();
+}
+
+// PlayMany(): bulk start on the default scheduler.
+void Animation::PlayMany(const Vector<Ctrl*>& owners, const Staging& spec,
+                         TickFactory tick_factory, int stagger_ms)
+{
+    Scheduler::Default().PlayMany(owners, spec, pick(tick_factory), stagger_ms);
+}
+
+// Launch(): fire-and-forget run on the default scheduler.
+AnimHandle Animation::Launch(Ctrl& owner, Staging spec, int prop)
+{
+    return Scheduler::Default().Launch(owner, pick(spec), prop);
+}
+
+// OnFrame()/CancelFrame(): per-frame hooks on the default scheduler.
+int Animation::OnFrame(Ctrl& owner, Function<bool(int64, double)> fn) {
+    return Scheduler::Default().OnFrame(owner, pick(fn));
+}
+
+void Animation::CancelFrame(int id) {
+    Scheduler::Default().CancelFrame(id);
+}
+
+// FrameTime(): frame-consistent timestamp of the default scheduler.
+int64 Animation::FrameTime() {
+    return Scheduler::Default().FrameTime();
+}
+
+// SetImmediate(): immediate first frame default on the default scheduler.
+void Animation::SetImmediate(bool b) {
+    Scheduler::Default().SetImmediate(b);
+}
+
+// SetFixedStep(): fixed-timestep simulation on the default scheduler.
+void Animation::SetFixedStep(int hz, int max_steps_per_frame) {
+    Scheduler::Default().SetFixedStep(hz, max_steps_per_frame);
+}
+
+// SetClockSource(): external clock slaving on the default scheduler.
+void Animation::SetClockSource(Function<double()> clock, double max_slew, int seek_ms) {
+    Scheduler::Default().SetClockSource(pick(clock), max_slew, seek_ms);
+}
+
+// SetAutoFPS(): adaptive FPS governor on the default scheduler.
+void Animation::SetAutoFPS(bool b, int min_fps) {
+    Scheduler::Default().SetAutoFPS(b, min_fps);
+}
+
+// GetEffectiveFPS(): default scheduler rate after governing.
+int Animation::GetEffectiveFPS() {
+    return Scheduler::Default().GetEffectiveFPS();
+}
+
+// SetFPS(): change default scheduler FPS; re-arms the timer loop if running.
 void Animation::SetFPS(int fps) {
-    Scheduler::Inst().SetFPSInternal(fps);
+    Scheduler::Default().SetFPS(fps);
 }
 
-// GetFPS(): read current target FPS.
+// GetFPS(): read default scheduler FPS.
 int Animation::GetFPS() {
-    return Scheduler::Inst().GetFPSInternal();
+    return Scheduler::Default().GetFPS();
+}
+
+/*---------------- Concurrency cap ----------------*/
+
+// SetMaxActive(): cap concurrent runs; surplus is completed per 'policy'.
+void Animation::SetMaxActive(int n, int policy) {
+    Scheduler::Default().SetMaxActive(n, policy);
+}
+
+// GetMaxActive(): current cap (0 = unlimited).
+int Animation::GetMaxActive() {
+    return Scheduler::Default().GetMaxActive();
 }
 
 /*---------------- Global helpers ----------------*/
 
-// KillAllFor(): abort all animations for the given Ctrl; Progress=0.0.
+// KillAllFor(): abort all animations for the given Ctrl on every scheduler.
 void Animation::KillAllFor(Ctrl& c)
 {
-    Scheduler::Inst().KillFor(&c);
+    for (Scheduler* s : Schedulers())
+        s->KillAllFor(c);
 }
 
-// Finalize(): stop scheduler; free all states; sever back-pointers safely.
+// Finalize(): stop every scheduler; free all states; sever back-pointers safely.
 void Animation::Finalize()
 {
-    Scheduler::Inst().Finalize();
+    for (Scheduler* s : Schedulers())
+        s->Finalize();
 }
 
-/*---------------- Scheduler → Animation hooks ----------------*/
+/*---------------- Scheduler → Animation hook ----------------*/
 
-// Finish path: cache 1.0 and clear live_.
-void Animation::_OnStateRemovedFinish() {
-    progress_cache_ = 1.0;
-    live_ = nullptr;
+// The run ended (finish: 1.0, cancel: snapshot, kill: 0.0); clear live_.
+void Animation::_OnStateRemoved(double p) {
+    progress_cache_ = clamp(p, 0.0, 1.0);
+    live_ = AnimHandle();
 }
 
-// Cancel/kill path: cache provided forward progress snapshot and clear live_.
-void Animation::_OnStateRemovedCancel(double p) {
-    progress_cache_ = clamp(p, 0.0, 1.0);
-    live_ = nullptr;
+/*==================== AnimHandle ====================*/
+
+bool AnimHandle::IsAlive() const
+{
+    return Animation::Scheduler::Resolve(*this);
+}
+
+bool AnimHandle::IsPlaying() const
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    return s && !s->paused;
+}
+
+bool AnimHandle::IsPaused() const
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    return s && s->paused;
+}
+
+double AnimHandle::Progress() const
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    return s ? s->Progress(s->sched->FrameTime()) : 0.0;
+}
+
+void AnimHandle::Pause()
+{
+    if (Animation::State* s = Animation::Scheduler::Resolve(*this))
+        s->sched->PauseRun(s);
+}
+
+void AnimHandle::Resume()
+{
+    if (Animation::State* s = Animation::Scheduler::Resolve(*this))
+        s->sched->ResumeRun(s);
+}
+
+void AnimHandle::Stop()
+{
+    if (Animation::State* s = Animation::Scheduler::Resolve(*this))
+        s->sched->Complete(s);
+}
+
+void AnimHandle::Cancel(bool fire_cancel)
+{
+    if (Animation::State* s = Animation::Scheduler::Resolve(*this))
+        s->sched->CancelRun(s, fire_cancel);
+}
+
+void AnimHandle::SetTarget(double to)
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    if (s && s->spec->kind == Animation::RUN_SPRING)
+        s->SetTarget(to, s->sched->FrameTime());
+}
+
+double AnimHandle::GetTarget() const
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    return s ? s->EndValue() : 0.0;
+}
+
+int64 AnimHandle::GetEndTime() const
+{
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    if (!s || s->spec->kind != Animation::RUN_DECAY)
+        return -1;
+    if (!s->seeded)
+        s->Seed();
+    return s->EndTime();
+}
+
+/*==================== ProgressSource ====================*/
+
+ProgressSource::~ProgressSource()
+{
+    ++depth;                    // a cancelled run may not prune under us
+    for (int i = 0; i < runs.GetCount(); ++i)
+        if (Animation::State* s = Animation::Scheduler::Resolve(runs[i]))
+            s->sched->CancelRun(s, false);
+}
+
+void ProgressSource::Set(double v)
+{
+    if (v == value)
+        return;
+    value = v;
+    StepRuns();
+}
+
+ProgressSource& ProgressSource::Range(double l, double h)
+{
+    lo = l;
+    hi = h;
+    StepRuns();
+    return *this;
+}
+
+double ProgressSource::GetProgress() const
+{
+    return hi != lo ? clamp((value - lo) / (hi - lo), 0.0, 1.0) : value >= hi ? 1.0 : 0.0;
+}
+
+int ProgressSource::GetLinkCount() const
+{
+    int n = 0;
+    for (AnimHandle h : runs)
+        if (h.IsAlive()) ++n;
+    return n;
+}
+
+// One step per linked run, in link order; the outermost call drops the
+// handles of runs that have ended.
+void ProgressSource::StepRuns()
+{
+    ++depth;
+    for (int i = 0; i < runs.GetCount(); ++i)
+        if (Animation::State* s = Animation::Scheduler::Resolve(runs[i]))
+            if (!s->dying)
+                s->sched->StepFirst(s);
+    if (--depth == 0) {
+        int j = 0;
+        for (int i = 0; i < runs.GetCount(); ++i)
+            if (runs[i].IsAlive())
+                runs[j++] = runs[i];
+        runs.Trim(j);
+    }
 }
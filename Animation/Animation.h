@@ -11,9 +11,13 @@
 //                write here. Staging is created lazily by setters.
 //   • State    — the live, scheduled run (immutable snapshot of Staging).
 //
+// Committed specs are immutable and reference counted (SpecRef): the run,
+// last_spec_ and later replays share one copy; a setter clones only when the
+// spec it would modify is shared (copy-on-write).
+//
 // On Play():
-//   - If a fresh staging exists → commit it (Staging → State), cache it as
-//     last_spec_ (for Replay), consume staging (staging_ becomes nullptr).
+//   - If a fresh staging exists → commit it (Staging → State), share it as
+//     last_spec_ (for Replay), consume staging (staging_ becomes null).
 //   - Else if a last spec exists → reuse it (natural "play again").
 //   - Else → no-op (we never run with unintentional defaults).
 //
@@ -29,16 +33,25 @@
 //   - last_spec_ is *kept*, so Replay() still works.
 //
 // Progress():
-//   - Returns normalized **time** progress in [0..1] (independent of easing).
+//   - Returns normalized **time** progress in [0..1] (independent of easing),
+//     per leg for loop/yoyo runs; 1.0 only at the end of the final leg.
 //
 // Pseudo-usage (compact):
 //   Animation a(ctrl);
 //   a.Duration(300).Ease(Easing::OutCubic())([](double e){ /* draw/e */ return true; }).Play();
 //   a.Pause(); a.Resume(); a.Cancel(); a.Reset(); a.Replay();
 //
+// Schedulers:
+//   - Runs are driven by an Animation::Scheduler (timer, FPS, pause state and
+//     clock). Scheduler::Default() is the process-wide instance used unless an
+//     Animation is bound to another one (e.g. one per TopWindow).
+//
 // Notes:
-//   - All lifecycle hooks use Event<> (U++-style). Per-frame tick uses Function<>.
-//   - Convenience helpers (AnimateValue/Color/Rect) are provided.
+//   - Lifecycle hooks use SmallEvent<>, the per-frame tick and easing use
+//     SmallFunction<> (inline storage; accept lambdas, Event<>/Function<>).
+//   - The scheduler owns all run state. Animation refers to its run through
+//     a generational AnimHandle, so it can be moved freely; Launch() and
+//     AnimateValue/Color/Rect start fire-and-forget runs and return a handle.
 //
 // ------------------------------------------------------------------------------
 
@@ -48,13 +61,101 @@
 #include <Core/Core.h>
 #include <CtrlCore/CtrlCore.h>
 
+namespace Upp {
+
+/*---------------- SmallFunction: inline-storage callable ----------------------
+   Function<> counterpart for animation hooks. Callables up to INLINE_SIZE
+   bytes (a lambda capturing 'this' and a few values, a member delegate) are
+   stored inline and invoked through one plain function pointer; larger ones
+   fall back to the heap. Copyable like Function<>; an empty Function<>
+   converts to an empty SmallFunction. Calling an empty one returns R().
+-----------------------------------------------------------------------------*/
+template <class Sig> class SmallFunction;
+
+template <class R, class... A>
+class SmallFunction<R(A...)> {
+public:
+    enum { INLINE_SIZE = 48 };
+
+    SmallFunction() {}
+    SmallFunction(std::nullptr_t) {}
+    SmallFunction(const Function<R(A...)>& f)      { if (f) Set(f); }
+    SmallFunction(Function<R(A...)>&& f)           { if (f) Set(pick(f)); }
+
+    template <class F, class D = std::decay_t<F>,
+              class = std::enable_if_t<!std::is_same<D, SmallFunction>::value &&
+                                       !std::is_same<D, Function<R(A...)>>::value &&
+                                       std::is_invocable_r<R, D&, A...>::value>>
+    SmallFunction(F&& f)                           { Set(std::forward<F>(f)); }
+
+    // Member delegate: object + method, always inline.
+    template <class T>
+    SmallFunction(T* obj, R (T::*m)(A...))         { Set([obj, m](A... a) -> R { return (obj->*m)(std::forward<A>(a)...); }); }
+
+    SmallFunction(const SmallFunction& b)          { if (b.ops) { b.ops->copy(buf, b.buf); ops = b.ops; } }
+    SmallFunction(SmallFunction&& b)               { Take(b); }
+    SmallFunction& operator=(const SmallFunction& b) { if (this != &b) { SmallFunction t(b); Clear(); Take(t); } return *this; }
+    SmallFunction& operator=(SmallFunction&& b)    { if (this != &b) { Clear(); Take(b); } return *this; }
+    ~SmallFunction()                               { Clear(); }
+
+    R operator()(A... a) const                     { return ops ? ops->call(const_cast<byte*>(buf), std::forward<A>(a)...) : R(); }
+    explicit operator bool() const                 { return ops; }
+    bool IsInline() const                          { return ops && !ops->heap; }
+    void Clear()                                   { if (ops) { ops->destroy(buf); ops = nullptr; } }
+
+    // The stored callable if it is an F (cf. std::function::target), else nullptr.
+    template <class F> F* Target()                 { return ops == &Impl<F, OnHeap<F>>::table ? Impl<F, OnHeap<F>>::Get(buf) : nullptr; }
+    template <class F> const F* Target() const     { return const_cast<SmallFunction *>(this)->template Target<F>(); }
+
+private:
+    struct Ops {
+        R    (*call)(void*, A...);
+        void (*copy)(void* dst, const void* src);
+        void (*move)(void* dst, void* src);  // move-construct dst, destroy src
+        void (*destroy)(void*);
+        bool heap;
+    };
+
+    template <class F, bool Heap>
+    struct Impl {
+        static F*   Get(void* p)                   { if constexpr (Heap) return *(F**)p; else return (F*)p; }
+        static R    Call(void* p, A... a)          { return (*Get(p))(std::forward<A>(a)...); }
+        static void Copy(void* d, const void* s)   { const F& f = *Get(const_cast<void*>(s));
+                                                     if constexpr (Heap) *(F**)d = new F(f); else new(d) F(f); }
+        static void Move(void* d, void* s)         { if constexpr (Heap) *(F**)d = *(F**)s;
+                                                     else { new(d) F(pick(*(F*)s)); ((F*)s)->~F(); } }
+        static void Destroy(void* p)               { if constexpr (Heap) delete *(F**)p; else ((F*)p)->~F(); }
+        static constexpr Ops table = { &Call, &Copy, &Move, &Destroy, Heap };
+    };
+
+    template <class D>
+    static constexpr bool OnHeap = sizeof(D) > INLINE_SIZE || alignof(D) > alignof(std::max_align_t);
+
+    template <class F>
+    void Set(F&& f) {
+        typedef std::decay_t<F> D;
+        constexpr bool heap = OnHeap<D>;
+        if constexpr (heap) *(D**)buf = new D(std::forward<F>(f));
+        else                new(buf) D(std::forward<F>(f));
+        ops = &Impl<D, heap>::table;
+    }
+    void Take(SmallFunction& b)                    { if (b.ops) { b.ops->move(buf, b.buf); ops = b.ops; b.ops = nullptr; } }
+
+    alignas(std::max_align_t) byte buf[INLINE_SIZE];
+    const Ops* ops = nullptr;
+};
+
+template <class... A> using SmallEvent = SmallFunction<void(A...)>;
+
+} // namespace Upp
+
 /*---------------- Easing helpers (constexpr cubic-bézier) ----------------
    Factory + presets for CSS-like cubic Bézier easing.
    Use presets (Easing::OutCubic()) or build your own with Bezier(x1,y1,x2,y2).
 -----------------------------------------------------------------------------*/
 namespace Easing {
 
-using Fn = Upp::Function<double(double)>;
+using Fn = Upp::SmallFunction<double(double)>;
 
 namespace detail { // Unit-time cubic Bézier with P0=(0,0) and P3=(1,1)
 constexpr double BX(double x1, double x2, double t) noexcept {
@@ -117,8 +218,65 @@ inline constexpr auto OutBounce()     { return Bezier(0.680, -0.550, 0.265, 1.55
 
 namespace Upp {
 
+/*---------------- AnimHandle: generational run reference -----------------------
+   32-bit id of a scheduled run: slot index in the low INDEX_BITS, the slot's
+   generation above. A plain value: copy it, keep it in a Vector, let it
+   outlive the run. When the run ends (finish, cancel, KillAllFor) its slot
+   generation advances, so every call on a dead handle is a checked O(1)
+   no-op. The scheduler owns the run; the handle never does.
+-----------------------------------------------------------------------------*/
+template <class T, class = void> struct HasValueComponents; // ValueTraits<T> has a component view
+template <class T, bool = HasValueComponents<T>::value> struct ValueTrack; // value run tick (see AnimateValue)
+class ProgressSource;                      // input-linked progress (see Link)
+
+class AnimHandle : Moveable<AnimHandle> {
+public:
+    enum { INDEX_BITS = 20, GEN_BITS = 12 };
+
+    AnimHandle() {}
+
+    bool   IsAlive() const;                // run still scheduled
+    bool   IsPlaying() const;              // alive and not paused
+    bool   IsPaused() const;               // alive and paused
+    double Progress() const;               // time progress [0..1]; 0 when dead
+
+    void   Pause();                        // reversible freeze
+    void   Resume();                       // continue after Pause()
+    void   Stop();                         // finish now: final tick, on_finish
+    void   Cancel(bool fire_cancel = true);// abort; on_cancel unless silent
+    void   SetTarget(double to);           // spring runs: new target, velocity kept
+    double GetTarget() const;              // spring target / decay resting position
+    int64  GetEndTime() const;             // decay: clock time it rests; -1 unknown/dead
+
+    // Value runs (tick is a ValueTrack<T>): new target for the run in flight,
+    // reusing its State. mode: Animation::RETARGET_*. False if dead or not a
+    // ValueTrack<T> run.
+    template <class T>
+    bool   Retarget(const T& to, int mode = 0);
+
+    dword  GetId() const                   { return id; }
+    bool   IsNull() const                  { return id == 0; }
+    bool   operator==(const AnimHandle& b) const { return id == b.id; }
+    bool   operator!=(const AnimHandle& b) const { return id != b.id; }
+
+private:
+    dword id = 0;                          // 0: null handle
+
+    explicit AnimHandle(dword id) : id(id) {}
+    friend class Animation;
+};
+
 class Animation {
 public:
+    class Scheduler;
+    class Batch;
+
+    // Run kinds. RUN_TWEEN runs map time to eased [0..1] over duration/
+    // loops; RUN_SPRING runs are damped springs evaluated in closed form
+    // from elapsed time, and end at rest; RUN_DECAY runs coast from an
+    // initial velocity under friction (fling), then spring onto a bound.
+    enum RunKind { RUN_TWEEN, RUN_SPRING, RUN_DECAY };
+
     /*---------------- Staging describes the next run ("the recipe") ------------
        All setters write here prior to Play(). On Play(), a snapshot of Staging
        is embedded into a live State for deterministic execution.
@@ -129,44 +287,134 @@ public:
         int  loop_count  = 1;                    // number of legs; -1 = infinite
         int  delay_ms    = 0;                    // start delay (ms)
         bool yoyo        = false;                // forward then reverse per cycle
+        int  priority    = 0;                    // eviction rank under SetMaxActive (higher survives)
+        int  max_hz      = 0;                    // update rate cap; 0 = every scheduler frame
+        int  immediate   = -1;                   // first frame inside Play(): 1/0; -1 = scheduler default
         Easing::Fn easing = Easing::InOutCubic();// easing function (t in 0..1)
 
+        // Spring runs (Spring/SmoothDamp): the tick and on_update get the
+        // position, moving from 'from' to 'to' (it may overshoot); duration,
+        // loops, yoyo and easing do not apply. The run ends once the remaining
+        // amplitude |x - to| + |v| / w0 drops below 'rest', delivering 'to'.
+        int    kind      = RUN_TWEEN;
+        double from      = 0, to = 1;            // start position, target
+        double velocity  = 0;                    // initial velocity (units/s)
+        double stiffness = 170, damping = 26, mass = 1;
+        double rest      = 0.001;                // rest amplitude (units)
+
+        // Decay runs (Decay): velocity decays as v * exp(-friction * t) from
+        // 'from'; the run ends where it comes to rest. Crossing a bound
+        // switches to the spring above, settling on the bound.
+        double friction  = 2;                    // decay rate (1/s)
+        double bound_lo  = -DBL_MAX, bound_hi = DBL_MAX;
+
+        // Linked tween runs (Link): progress comes from this source instead
+        // of the clock. A null source (never set, or destroyed) plays on time.
+        Ptr<ProgressSource> link;
+
         // Per-frame tick. Receives eased t in [0..1]. Return false to stop early.
-        Function<bool(double)> tick;
+        SmallFunction<bool(double)> tick;
 
         // Lifecycle hooks. on_update(e) fires every frame with eased value.
-        Event<>      on_start, on_finish, on_cancel;
-        Event<double> on_update;
+        // on_leg(skipped) fires on frames that cross a loop/yoyo leg boundary;
+        // 'skipped' counts whole legs jumped over (0 unless the frame stalled).
+        // on_render(alpha) fires once per display frame in fixed-step mode,
+        // alpha in [0..1) being the position between the last two sim steps.
+        SmallEvent<>       on_start, on_finish, on_cancel;
+        SmallEvent<double> on_update;
+        SmallEvent<int>    on_leg;
+        SmallEvent<double> on_render;
+    };
+
+    /*---------------- SpecRef: shared immutable spec ------------------------------
+       Committed Staging, reference counted (UI thread only) so several runs
+       can share one copy: PlayMany() starts a whole list on a single spec.
+    ---------------------------------------------------------------------------*/
+    class SpecRef {
+    public:
+        SpecRef() {}
+        SpecRef(const SpecRef& b) : p(b.p)   { if (p) ++p->refs; }
+        SpecRef(SpecRef&& b) : p(b.p)        { b.p = nullptr; }
+        SpecRef& operator=(SpecRef b)        { Swap(p, b.p); return *this; }
+        ~SpecRef()                           { if (p && --p->refs == 0) delete p; }
+
+        static SpecRef Make(Staging&& s)     { SpecRef r; r.p = new Shared(pick(s)); return r; }
+
+        // Copy-on-write access: clones first if the spec is shared.
+        Staging& Write()                     { if (p->refs > 1) *this = Make(Staging(*p)); return *p; }
+
+        const Staging* operator->() const    { return p; }
+        const Staging& operator*() const     { return *p; }
+        explicit operator bool() const       { return p; }
+        int  GetRefCount() const             { return p ? p->refs : 0; }
+
+    private:
+        struct Shared : Staging {
+            int refs = 1;
+            explicit Shared(Staging&& s) : Staging(pick(s)) {}
+        };
+        Shared* p = nullptr;
     };
 
     /*---------------- State is the live scheduled run ("the execution") --------
-       Owned by the scheduler. Immutable settings copied from Staging at Play()
-       time; holds timing/yoyo bookkeeping for the current run.
+       Owned by the scheduler. Immutable settings shared from Staging at Play()
+       time. Leg, direction and completion are derived arithmetically from the
+       total run time, so any frame gap resolves in O(1) without phase drift.
     ---------------------------------------------------------------------------*/
-    struct State : Pte<State> {
+    struct State {
         Ptr<Ctrl> owner;         // safe watcher of owning Ctrl
-        Staging   spec;          // immutable snapshot of the staging config
-        int64     start_ms   = 0;// current leg start wall time
-        int64     elapsed_ms = 0;// accumulated time when paused
+        SpecRef   spec;          // immutable snapshot of the staging config
+        SmallFunction<bool(double)> tick; // per-run tick (PlayMany); else spec->tick
+        int64     start_ms   = 0;// clock time of Play() / last Resume()
+        int64     elapsed_ms = 0;// run time accumulated before the last Pause()
         bool      paused     = false;
-        bool      reverse    = false;
-        int       cycles     = 1;// remaining cycles (if loop_count >= 0)
+        bool      reverse    = false;// current leg runs 1 → 0 (yoyo)
+        int64     leg        = 0;// index of the leg delivered last
+        int64     due_ms     = 0;// next step time when spec.max_hz > 0
 
-        Animation* anim  = nullptr; // back-pointer (non-owning)
+        dword      handle = 0;      // AnimHandle id; 0 once the run is retired
+        double     x0 = 0, v0 = 0;  // spring segment: start position, velocity (units/s)
+        double     target = 0;      // segment target (decay: final resting position)
+        double     seg_ms = 0;      // run time the segment starts at
+        double     cross_ms = -1;   // decay: run time it crosses a bound; -1 = never
+        double     end_ms = -1;     // decay: run time it comes to rest; -1 = unknown
+        bool       seeded = false;  // segment initialized from the spec
+        bool       settling = false;// decay: spring phase onto the bound
+        int        prop   = 0;      // property key with owner (Launch); 0 = none
+        Scheduler* sched = nullptr; // scheduler that owns this state (clock source)
         bool       dying = false;   // deferred removal flag during sweep
+        bool       culled = false;  // owner not visible: advance time, skip ticks
+        bool       linked = false;  // stepped by spec.link, never by the timer
 
         // Advance to 'now'. Returns true to keep scheduling; false to stop.
-        bool Step(int64 now);
+        bool  Step(int64 now);
+        int64 LegCount() const;  // total legs of the run; -1 = infinite
+        int64 EndTime() const;   // clock time the run completes; -1 = never
+        void  ScheduleNext(int64 now); // next due_ms on the max_hz grid
+        double Progress(int64 now) const; // leg time progress [0..1] at 'now'; springs: distance covered
+        double LegProgress(int64 t, int64& cur) const; // tween: leg 'cur' and progress in it at run time t
+        int64 RunTime(int64 now) const; // run time after the delay at 'now'
+        double EndValue() const;        // tick value of a completed run
+        void  Sample(int64 t, double& x, double& v) const; // spring position/velocity at run time t
+        void  Seed();                   // spring segment from the spec
+        void  SetTarget(double to, int64 now); // spring: new segment from current x, v
+        void  Settle();                 // decay: switch to the spring at the bound
+        bool  StepSpring(int64 t);      // spring and decay runs
+        bool  StepTween(double t, bool finish); // tween frame at run time t
+        double LinkTime() const;        // linked: run time at the source position
+        bool  Tick(double e)     { return tick ? tick(e) : spec->tick ? spec->tick(e) : true; }
     };
 
     /*---------------- Lifecycle -------------------------------------------------
        Construct an animation bound to a control. Destructor detaches safely.
     ---------------------------------------------------------------------------*/
     explicit Animation(Ctrl& owner);
+    Animation(Ctrl& owner, Scheduler& sched);   // bind to a specific scheduler
     ~Animation();
 
-    Animation(Animation&&) = default;
-    Animation& operator=(Animation&&) = default;
+    // Moving rebinds the run's slot to the new object in O(1).
+    Animation(Animation&& b);
+    Animation& operator=(Animation&& b);
     Animation(const Animation&) = delete;
     Animation& operator=(const Animation&) = delete;
 
@@ -180,18 +428,38 @@ public:
     Animation& Loop(int n = -1);                     // loop count (-1: infinite)
     Animation& Yoyo(bool b = true);                  // reverse direction per loop
     Animation& Delay(int ms);                        // start delay (ms)
+    Animation& Priority(int p);                      // eviction rank (see SetMaxActive)
+    Animation& MaxRate(int hz);                      // update at most hz times/s (0: every frame)
+    Animation& Immediate(bool b = true);             // deliver the t=0 frame inside Play()
+
+    // Spring runs (see Staging): ticks get positions from 'from' to 'to'.
+    // On a decay run Spring() sets the spring that settles it on a bound.
+    Animation& Spring(double stiffness = 170, double damping = 26, double mass = 1);
+    Animation& SmoothDamp(int smooth_ms);            // critically damped follower, lag ~smooth_ms
+    Animation& Range(double from, double to);        // spring start and target
+    Animation& Velocity(double units_per_s);         // spring initial velocity
+    Animation& Rest(double amplitude);               // spring/decay rest threshold
+    Animation& Decay(double from, double velocity, double friction = 2); // fling from 'from'
+    Animation& Bounds(double lo, double hi);         // decay: settle inside [lo, hi]
+    Animation& Link(ProgressSource& src);            // tween progress from 'src', not time
 
-    Animation& OnStart(const Event<>& cb);           // set on_start hook
-    Animation& OnStart(Event<>&& cb);                // set on_start (move)
-    Animation& OnFinish(const Event<>& cb);          // set on_finish hook
-    Animation& OnFinish(Event<>&& cb);               // set on_finish (move)
-    Animation& OnCancel(const Event<>& cb);          // set on_cancel hook
-    Animation& OnCancel(Event<>&& cb);               // set on_cancel (move)
-    Animation& OnUpdate(const Event<double>& cb);    // per-frame eased value
-    Animation& OnUpdate(Event<double>&& cb);         // per-frame eased value (move)
+    // Hooks accept lambdas, Event<>/Function<> and member delegates
+    // (SmallEvent(this, &X::Method)); small captures are stored inline.
+    Animation& OnStart(const SmallEvent<>& cb);           // set on_start hook
+    Animation& OnStart(SmallEvent<>&& cb);                // set on_start (move)
+    Animation& OnFinish(const SmallEvent<>& cb);          // set on_finish hook
+    Animation& OnFinish(SmallEvent<>&& cb);               // set on_finish (move)
+    Animation& OnCancel(const SmallEvent<>& cb);          // set on_cancel hook
+    Animation& OnCancel(SmallEvent<>&& cb);               // set on_cancel (move)
+    Animation& OnUpdate(const SmallEvent<double>& cb);    // per-frame eased value
+    Animation& OnUpdate(SmallEvent<double>&& cb);         // per-frame eased value (move)
+    Animation& OnLeg(const SmallEvent<int>& cb);          // leg boundary (arg: legs skipped)
+    Animation& OnLeg(SmallEvent<int>&& cb);               // leg boundary (move)
+    Animation& OnRender(const SmallEvent<double>& cb);    // fixed-step render (arg: alpha)
+    Animation& OnRender(SmallEvent<double>&& cb);         // fixed-step render (move)
 
-    Animation& operator()(const Function<bool(double)>& f); // per-frame tick
-    Animation& operator()(Function<bool(double)>&& f);      // per-frame tick (move)
+    Animation& operator()(const SmallFunction<bool(double)>& f); // per-frame tick
+    Animation& operator()(SmallFunction<bool(double)>&& f);      // per-frame tick (move)
 
     /*---------------- Control ---------------------------------------------------
        Play() commits the staged config and schedules a new run.
@@ -207,93 +475,733 @@ public:
     void   Reset();     // silent abort; prime fresh staging; Progress=0; keep last_spec_
     void   Replay();    // (re)start using last_spec_; silently interrupts if running
 
+    // Scheduler used by the next Play(); a running state stays on its own.
+    Animation& SetScheduler(Scheduler& s);
+    Scheduler& GetScheduler() const;
+
     // True if a previous Play() established a spec we can Replay().
     bool   HasReplay() const;
+    const SpecRef& GetLastSpec() const { return last_spec_; } // what Replay() runs (shared)
 
     bool   IsPlaying() const;              // scheduled and not paused
     bool   IsPaused()  const;              // scheduled and paused
     double Progress()  const;              // normalized time progress [0..1]
 
+    // Value runs: tick from a ValueTrack<T> (set per frame, from → to), so
+    // Retarget() can steer the run in flight.
+    template <class T>
+    Animation& Value(Event<const T&> set, T from, T to) { EnsureStaging_().tick = ValueTrack<T>(*owner_, pick(set), from, to); return *this; }
+
+    // New destination for the running value run, without a new State: the
+    // path restarts from the current value. RETARGET_BLEND keeps the
+    // velocity and runs a full duration, RETARGET_KEEP_END keeps the velocity
+    // and the original end time, RETARGET_RESTART starts the new leg at rest.
+    enum RetargetMode { RETARGET_BLEND, RETARGET_KEEP_END, RETARGET_RESTART };
+    template <class T>
+    bool   Retarget(const T& to, int mode = RETARGET_BLEND) { return live_.Retarget(to, mode); }
+
+    // Spring runs: move the target; position and velocity stay continuous.
+    void   SetTarget(double to)            { live_.SetTarget(to); }
+
+    // Where a decay run comes to rest, known before it starts (prefetch).
+    static double DecayEnd(double from, double velocity, double friction = 2,
+                           double lo = -DBL_MAX, double hi = DBL_MAX);
+    AnimHandle GetHandle() const { return live_; } // current run; dead once it ends
+
     /*---------------- Global helpers -------------------------------------------
-       Affect the shared scheduler. FPS changes re-arm the timer if needed.
+       Affect the default scheduler (KillAllFor/Finalize: every scheduler).
+       FPS changes re-arm the timer if needed.
     ---------------------------------------------------------------------------*/
     static void SetFPS(int fps);           // clamp [1..240]
     static int  GetFPS();
+
+    // Concurrency cap. When n > 0 active runs are reached, the policy decides
+    // which run gives way; the loser is snapped to its end state exactly like
+    // Stop() (final tick + on_finish). n <= 0 removes the cap.
+    enum CapPolicy {
+        CAP_EVICT_OLDEST,  // finish the oldest active run
+        CAP_EVICT_LOWEST,  // finish the lowest-priority run (oldest on ties; newcomer loses if lower)
+        CAP_REJECT_NEW,    // finish the newcomer unless it outranks every active run
+    };
+    static void SetMaxActive(int n, int policy = CAP_EVICT_OLDEST);
+    static int  GetMaxActive();
+
+    // Visibility culling (opt-in, default scheduler). See Scheduler::SetCulling.
+    static void SetCulling(bool b = true, int check_ms = 100);
+
+    // Idle hysteresis (default scheduler). See Scheduler::SetIdleGrace.
+    static void SetIdleGrace(int ms);
+
+    // Immediate first frame default (default scheduler). See Scheduler::SetImmediate.
+    static void SetImmediate(bool b = true);
+
+    // Fixed-timestep simulation (default scheduler). See Scheduler::SetFixedStep.
+    static void SetFixedStep(int hz, int max_steps_per_frame = 8);
+
+    // External clock slaving (default scheduler). See Scheduler::SetClockSource.
+    static void SetClockSource(Function<double()> clock, double max_slew = 0.05, int seek_ms = 250);
+
+    // Adaptive FPS governor (default scheduler). See Scheduler::SetAutoFPS.
+    static void SetAutoFPS(bool b = true, int min_fps = 15);
+    static int  GetEffectiveFPS();
     static void KillAllFor(Ctrl& c);       // abort all animations for this Ctrl
-    static void Finalize();                // stop scheduler; free all states
+    static void Finalize();                // stop schedulers; free all states
+
+    // Frame-consistent timestamp of the default scheduler. See Scheduler::FrameTime.
+    static int64 FrameTime();
+
+    // Motion mode (process-wide, every scheduler; switchable at runtime).
+    // MOTION_REDUCED caps frames at 30 FPS and plays new runs at a quarter
+    // of their duration and delay. MOTION_INSTANT completes runs inside
+    // Play() (on_start, final tick, on_finish; the timer is never armed) and
+    // snaps runs in flight to their end when switched on. Replay() keeps the
+    // original timing for when full motion returns.
+    enum MotionMode { MOTION_FULL, MOTION_REDUCED, MOTION_INSTANT };
+    static void SetMotionMode(int mode);
+    static int  GetMotionMode();
+
+    // Start one fire-and-forget run per owner from a single shared spec:
+    // tick_factory(i, owner) supplies each run's tick (a run whose factory
+    // tick is empty, or every run without a factory, uses the spec's tick),
+    // run i starts i * stagger_ms later. Default scheduler; see Scheduler::PlayMany.
+    typedef Function<SmallFunction<bool(double)>(int i, Ctrl& owner)> TickFactory;
+    static void PlayMany(const Vector<Ctrl*>& owners, const Staging& spec,
+                         TickFactory tick_factory, int stagger_ms = 0);
+
+    // Start one fire-and-forget run of 'spec' for 'owner' on the default
+    // scheduler; no Animation object is needed. A non-zero 'prop' keys the
+    // run by (owner, prop): it supersedes a live run on the same key. See
+    // Scheduler::Launch.
+    static AnimHandle Launch(Ctrl& owner, Staging spec, int prop = 0);
+
+    // Per-frame hook on the default scheduler. See Scheduler::OnFrame.
+    static int  OnFrame(Ctrl& owner, Function<bool(int64 now, double dt)> fn);
+    static void CancelFrame(int id);
 
     // Tests/diagnostics: step scheduler n frames; clamp each dt to max_ms_per_tick.
     static void Tick(int n = 1, int max_ms_per_tick = 0);
     static inline void TickOnce() { Tick(1, 0); }
 
-    // Scheduler → Animation hooks (update cached Progress on removal paths)
-    void _OnStateRemovedFinish();                        // Progress ← 1.0
-    void _OnStateRemovedCancel(double forward_snapshot); // Progress ← snapshot
+    // Simulated time on the default scheduler. See Scheduler::AdvanceTime.
+    static void AdvanceTime(int64 ms, int frame_ms = 16);
+    static void SetVirtualClock(bool b = true);
 
 private:
+    friend class AnimHandle;
+
     // Owner and staging
     Ctrl*        owner_ = nullptr;     // non-owning: the target control
-    One<Staging> staging_box_;         // storage for staging config (lazy)
-    Staging*     staging_ = nullptr;   // points into staging_box_ while staging
-    Ptr<State>   live_;                // scheduler-owned state; Ptr guards UAF
+    Ptr<Scheduler> sched_;             // bound scheduler; null → Scheduler::Default()
+    SpecRef      staging_;             // next run's spec (copy-on-write); null once consumed
+    AnimHandle   live_;                // scheduler-owned run; dead handle when idle
 
     // Progress cache that persists after Stop/Cancel, used when !live_.
     double       progress_cache_ = 0.0;
 
-    // Lazily (re)create staging only when a setter/operator() is called.
-    void EnsureStaging_();
+    // Lazily (re)create staging only when a setter/operator() is called;
+    // returns it writable (unshared).
+    Staging& EnsureStaging_();
 
     // Internal unschedule used by Cancel/Reset/Replay/~Animation
     void _Unschedule(bool fire_cancel);
 
-    // Cached copy of the last spec committed by Play(); persists across runs.
-    One<Staging> last_spec_box_;
-    bool         have_last_spec_ = false;
+    // Scheduler → Animation: the run ended; cache its final progress.
+    void _OnStateRemoved(double progress);
+
+    // Last spec committed by Play() (shared with its run); persists across runs.
+    SpecRef      last_spec_;
+};
+
+/*---------------- Scheduler ---------------------------------------------------
+   Drives a set of States from one TimeCallback at its own FPS. Each scheduler
+   has an independent clock (ms) that freezes while suspended, so Suspend() /
+   Resume() are O(1) regardless of how many runs it holds. Instances may be
+   created per TopWindow/timeline; Default() is the process-wide one.
+   Destroying a scheduler finalizes it (its Animations see a silent abort).
+-----------------------------------------------------------------------------*/
+class Animation::Scheduler : public Pte<Scheduler> {
+public:
+    static Scheduler& Default();           // process-wide instance
+
+    Scheduler();
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    void  SetFPS(int fps);                 // clamp [1..240]; re-arms timer
+    int   GetFPS() const                   { return fps; }
+
+    // Adaptive FPS governor. Measures frame cost (RunFrame duration) and
+    // timer lateness against the frame budget; sustained overrun lowers the
+    // effective FPS (not below min_fps), sustained headroom raises it back
+    // towards GetFPS(). Distinct thresholds/frame counts give hysteresis.
+    void  SetAutoFPS(bool b = true, int min_fps = 15);
+    bool  IsAutoFPS() const                { return auto_fps; }
+    int   GetEffectiveFPS() const          { return eff_fps; }
+
+    void  Suspend();                       // freeze clock + timer (e.g. minimised window)
+    void  Resume();                        // continue; time spent suspended is skipped
+    bool  IsSuspended() const              { return suspended; }
+    int64 Now() const;                     // scheduler clock (ms); sim time in fixed-step mode
+
+    // Frame-consistent time: the timestamp of the frame being delivered, or
+    // of the last frame while the timer runs at frame cadence. Only an idle
+    // (or sleeping) scheduler samples the clock, and that sample is kept for
+    // the rest of the event. Play/Pause/Resume/Progress use it, so runs
+    // started together share a start time and Progress() matches the value
+    // delivered in the current frame.
+    int64 FrameTime();
+
+    // Fixed-timestep mode (hz > 0; 0 = off). Runs step at exactly 1000/hz ms
+    // of simulation time, as many times per display frame as the elapsed
+    // time requires (at most max_steps_per_frame; a longer backlog is
+    // dropped and the sim clock slips). on_render(alpha) then fires once per
+    // frame, so results do not depend on SetFPS or timer jitter.
+    void  SetFixedStep(int hz, int max_steps_per_frame = 8);
+    int   GetFixedStep() const             { return fixed_hz; }
+
+    // External clock slaving: the run clock follows clock() (ms; a media
+    // playback position, a show controller) instead of msecs(). Attaching
+    // aligns the clock at once; then every frame measures the error and
+    // slews it out by running at most max_slew faster or slower (0.05: 5%),
+    // so motion stays smooth. An error beyond seek_ms is a seek: the clock
+    // jumps, on_seek(jump_ms) fires before the runs step, and runs resolve
+    // the jump like a stalled frame (a backward jump holds runs started
+    // later until the clock gets back). An empty clock detaches; the clock
+    // then goes on from where it is at the wall rate.
+    void  SetClockSource(Function<double()> clock, double max_slew = 0.05, int seek_ms = 250,
+                         Event<int64> on_seek = Event<int64>());
+    bool  IsSlaved() const                 { return (bool)ext_clock; }
+    double GetClockError() const           { return slave_err; } // external - run clock at the last frame (ms)
+    int   GetSeekCount() const             { return slave_seeks; }
+
+    // Runs with Staging::max_hz (MaxRate) form rate groups: runs of the same
+    // rate share due times on a common grid, and the timer sleeps until the
+    // earliest due group instead of waking every frame for all of them.
+    // Frame hooks and runs without a rate keep it at every frame.
+    int   GetWakeDelay();                  // ms the timer sleeps after this frame
+
+    void  SetMaxActive(int n, int policy = CAP_EVICT_OLDEST);
+    int   GetMaxActive() const             { return max_active; }
+
+    // Frame source. FRAME_TIMER (default) drives frames from the U++
+    // TimeCallback. FRAME_TIMERFD (Linux only) uses a helper thread blocking
+    // on a timerfd with absolute CLOCK_MONOTONIC deadlines; it wakes the GUI
+    // thread with one coalesced posted callback and the frame is stamped
+    // with the deadline, not with the time the callback gets to run. Frames
+    // are periodic at the effective FPS (MaxRate groups still step on their
+    // grid, the timer just does not sleep past them). Returns false (and
+    // keeps FRAME_TIMER) if the source is unavailable.
+    enum { FRAME_TIMER, FRAME_TIMERFD };
+    bool  SetFrameSource(int src);
+    int   GetFrameSource() const           { return frame_source; }
+
+    // Frame spacing of the timer-driven frames, to compare frame sources:
+    // histogram of |interval - requested interval| between frame timestamps.
+    struct FrameStats {
+        enum { BINS = 20, BIN_US = 250 };  // last bin collects the overflow
+        int64  frames  = 0;                // intervals recorded
+        int    hist[BINS] = {};
+        int64  max_us  = 0;                // worst deviation
+        double mean_us = 0;                // mean deviation
+
+        int    Percentile(double p) const; // deviation bound (us) covering p of frames
+        String ToString() const;
+    };
+    const FrameStats& GetFrameStats() const { return stats; }
+    void  ResetFrameStats();
+
+    // Opt-in visibility culling. Every check_ms the owners are tested
+    // (IsOpen, IsVisible, non-empty visible screen area); culled runs keep
+    // their clock but skip tick/on_update until visible again, when the next
+    // frame delivers the current value. Lifecycle hooks and the final tick
+    // of a finishing run are always delivered.
+    void  SetCulling(bool b = true, int check_ms = 100);
+    bool  IsCulling() const                { return cull; }
+
+    // Idle hysteresis: keep the timer armed this long after the last run
+    // ends or pauses, so a Cancel/Play burst does not re-arm the OS timer.
+    // 0 disarms immediately (pre-hysteresis behavior).
+    void  SetIdleGrace(int ms)             { idle_grace_ms = max(0, ms); }
+    int   GetIdleGrace() const             { return idle_grace_ms; }
+
+    // Immediate first frame: Play()/Replay() evaluate the run synchronously
+    // and deliver its t=0 frame (on_start, then tick) before returning, with
+    // the start time equal to that frame's timestamp; the next timer frame
+    // continues from there. Default for runs that do not set Immediate().
+    void  SetImmediate(bool b = true)      { immediate = b; }
+    bool  IsImmediate() const              { return immediate; }
+
+    // Per-frame hooks (requestAnimationFrame-style): fn(now, dt_ms) runs
+    // once per frame after the runs, with the same frame timestamp; return
+    // false to unsubscribe. Hooks die with their owner and keep the timer
+    // running while subscribed. Returns an id for CancelFrame().
+    int   OnFrame(Ctrl& owner, Function<bool(int64 now, double dt)> fn);
+    void  CancelFrame(int id);
+    int   GetFrameHookCount() const;
+
+    // Bulk start: all runs reference one shared spec and enter the active set
+    // in one operation (one timer Start). The runs have no Animation object;
+    // they end on their own, by returning false from the tick, or with their
+    // owner (KillAllFor). Motion mode and SetImmediate apply as for Play().
+    void  PlayMany(const Vector<Ctrl*>& owners, const Staging& spec,
+                   TickFactory tick_factory, int stagger_ms = 0);
+
+    // Fire-and-forget start: same as Animation::Play() (motion mode,
+    // immediate first frame, cap) but the run belongs to the scheduler and
+    // is controlled only through the returned handle.
+    // Property runs (prop != 0): at most one live run per (owner, prop). A
+    // new run on a live key supersedes it: the old run ends silently (no
+    // on_cancel/on_finish) and the new one takes over its handle, so the
+    // number of runs does not grow with the input rate.
+    AnimHandle Launch(Ctrl& owner, Staging spec, int prop = 0);
+    AnimHandle FindProperty(Ctrl& owner, int prop) const; // live run on the key, or null
+
+    // Tick of the live run on (owner, prop) if it is an F, else nullptr.
+    template <class F>
+    const F* FindPropertyTick(Ctrl& owner, int prop) const {
+        State* s = Resolve(FindProperty(owner, prop));
+        return s ? s->spec->tick.template Target<F>() : nullptr;
+    }
+
+    int   GetCount() const;                // scheduled (non-dying) runs
+    bool  IsRunning() const                { return running; } // timer armed
+    void  KillAllFor(Ctrl& c);             // abort runs of this Ctrl; Progress=0
+    void  Finalize();                      // stop timer; free all states
+    void  Tick(int n = 1, int max_ms_per_tick = 0); // manual stepping (tests)
+
+    // Virtual clock (tests, offline rendering): the clock stops following
+    // msecs() and moves only through AdvanceTime(); switching either way
+    // keeps it continuous. The frame timer is not armed meanwhile
+    // (IsRunning() still tells whether frames are wanted).
+    void  SetVirtualClock(bool b = true);
+    bool  IsVirtualClock() const           { return virtual_clock; }
+
+    // Advance the virtual clock (switched on if needed) by 'ms' in frames
+    // of frame_ms, the last one possibly shorter; every frame steps runs and
+    // hooks as a timer frame would. Deterministic and never sleeps.
+    void  AdvanceTime(int64 ms, int frame_ms = 16);
+
+private:
+    friend class Animation;
+    friend class AnimHandle;
+    friend class Batch;
+    friend class ProgressSource;
+
+    struct FrameHook {
+        int       id    = 0;
+        Ptr<Ctrl> owner;
+        Function<bool(int64, double)> fn;
+        int64     last  = 0;               // frame time of the previous call
+        bool      dying = false;
+    };
+
+    Vector<State*> active;                 // owns State* pointers
+    Array<FrameHook> hooks;                // OnFrame subscriptions
+    int   hook_seq  = 0;                   // last hook id handed out
+    Vector<State*> spare;                  // destroyed States kept for reuse (raw memory)
+    TimeCallback   ticker;                 // timer for frame updates
+    bool  running   = false;               // timer armed
+    int   timer_id  = 0;                   // invalidates queued ticks
+    int64 manual_last_now = 0;             // monotonic time for manual ticking
+    bool  sweeping  = false;               // true while RunFrame() iterates 'active'
+
+    int   fps     = 60;                    // frame pacing (target)
+    int   eff_fps = 60;                    // effective rate (== fps unless governed)
+    int   step_ms = 1000 / 60;
+
+    bool   auto_fps     = false;           // FPS governor
+    int    auto_min_fps = 15;
+    double gov_cost     = 0;               // smoothed frame cost (ms)
+    double gov_late     = 0;               // smoothed timer lateness (ms)
+    int    gov_over     = 0;               // consecutive overloaded frames
+    int    gov_under    = 0;               // consecutive frames with headroom
+    int64  armed_due    = 0;               // clock time the armed tick is due
+
+    int64 frame_now  = 0;                  // published frame timestamp
+    bool  frame_sync = false;              // frame_now valid for the current event
+    bool  sleeping   = false;              // timer armed beyond one frame (rate groups)
+
+    int   max_active = 0;                  // concurrency cap (0 = unlimited)
+    int   cap_policy = CAP_EVICT_OLDEST;
+
+    bool  cull       = false;              // visibility culling enabled
+    int   cull_ms    = 100;                // owner visibility re-check period
+    int64 cull_next  = 0;                  // clock time of the next check
+
+    int   idle_grace_ms = 100;             // timer hysteresis once idle
+    bool  immediate  = false;              // default for Staging::immediate
+    int64 idle_since = -1;                 // clock time the set went idle (-1: busy)
+    int   batch_depth = 0;                 // >0: timer arm/disarm deferred to EndBatch
+
+    int    fixed_hz  = 0;                  // fixed-step rate (0 = off)
+    int    fixed_max = 8;                  // max sim steps per display frame
+    double sim_ms    = 0;                  // simulation clock
+    double sim_acc   = 0;                  // wall time not yet simulated
+    int64  sim_wall  = 0;                  // wall time of the last frame
+
+    Function<double()> ext_clock;          // slaved: external time (ms)
+    Event<int64> on_seek;                  // slaved: clock jumped (ms)
+    double slave_ms    = 0;                // run clock - wall clock (ms)
+    double slave_slew  = 0.05;             // max correction per ms of wall time
+    int    slave_seek  = 250;              // larger error: jump instead of slew
+    int64  slave_wall  = 0;                // wall time of the last measurement
+    double slave_err   = 0;
+    int    slave_seeks = 0;
+
+    bool  virtual_clock = false;           // Clock() is virtual_ms, not msecs()
+    int64 virtual_ms = 0;
+
+    bool  suspended  = false;              // clock frozen at suspend_ms
+    int64 suspend_ms = 0;
+    int64 clock_skip = 0;                  // total ms spent suspended
+
+    struct FrameSource;                    // timerfd thread (Animation.cpp)
+    int   frame_source = FRAME_TIMER;
+    One<FrameSource> source;               // set for FRAME_TIMERFD
+    FrameStats stats;
+    int64 stats_last_us   = 0;             // previous frame stamp (0: none)
+    int64 stats_expect_us = 0;             // interval that was asked for
+
+    void  Start();
+    void  Stop();
+    void  Idle();
+    void  EndBatch();
+    void  MaybeStopIfAllPaused();
+    void  EnsureRunningIfAnyUnpaused();
+
+    bool  Add(State* s);
+    void  Remove(State* s);
+    void  Complete(State* s, bool scheduled = true);
+    int   LiveCount() const;
+    State* FindLowest() const;
+    State* FindOldest() const;
+    State* PickVictim(State* incoming) const;
+    void  TrimToCap();
+    void  UpdateCulling(int64 now);
+    State* NewState();                     // from the recycled pool if possible
+    void  DeleteState(State* s);
+    void  FreeSpare();
+
+    // Runs addressed by handle (slot table shared by all schedulers).
+    static State* Resolve(AnimHandle h);   // live state or nullptr
+    AnimHandle StartRun(Ctrl* owner, SpecRef spec, Animation* watcher, int prop = 0);
+    void  Retire(State* s, double progress); // end of run: free slot, notify Animation
+    void  PauseRun(State* s);
+    void  ResumeRun(State* s);
+    void  CancelRun(State* s, bool fire_cancel);
+    void  LinkRun(State* s);               // register a linked run with its source
+
+    int64 Clock() const                    { return virtual_clock ? virtual_ms : msecs(); }
+    int64 Wall() const;                    // Clock() minus suspended time
+    int64 RunClock() const;                // wall clock plus the slaving offset
+    int64 Slave(int64 wall);               // measure/correct drift; run clock at 'wall'
+    void  SyncSim();                       // idle fixed-step: sim clock catches up
+    int   WakeDelay(int64 now) const;      // ms until the earliest due run
+    bool  StepOne(State* s, int64 now);
+    void  StepFirst(State* s);
+    void  StepAll(int64 now);
+    void  StepHooks(int64 now);
+    bool  HasLiveHooks() const;
+    void  Purge();
+    void  RunFrame(int64 now);
+    void  SetEffectiveFPS(int f);
+    void  ApplyMotionMode();
+    void  Govern(double cost_ms, int64 late_ms);
+    void  TickTimer(int current_id);
+    void  SourceFrame();
+    void  RecordFrame(int64 stamp_us);
+    void  TickManualOnce(int max_ms_per_tick);
+};
+
+/*---------------- Batch -------------------------------------------------------
+   Scope guard that coalesces timer work: Play/Cancel/Pause/Resume/Stop inside
+   the scope take effect on the runs immediately, but arming or disarming the
+   scheduler's timer is decided once, when the outermost Batch ends.
+     { Animation::Batch b; hover_out.Cancel(); hover_in.Play(); }
+-----------------------------------------------------------------------------*/
+class Animation::Batch {
+public:
+    explicit Batch(Scheduler& s = Scheduler::Default()) : sched(s) { ++sched.batch_depth; }
+    ~Batch()                                                        { sched.EndBatch(); }
+
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+
+private:
+    Scheduler& sched;
+};
+
+/*---------------- ProgressSource: input-linked runs ---------------------------
+   A scalar (scroll offset, slider value) that drives tween runs instead of
+   the clock. Set() maps the value over Range(lo, hi) to [0..1] of each
+   linked run's timeline (delay, then every leg) and steps those runs right
+   away, with their easing, yoyo legs and tick. Linked runs never arm the
+   frame timer and do not finish at the end of the timeline (the input may
+   move back); they end by Stop/Cancel, or silently with the source.
+     sb.WhenScroll = [&] { header_src.Set(sb); };
+-----------------------------------------------------------------------------*/
+class ProgressSource : public Pte<ProgressSource> {
+public:
+    ProgressSource() {}
+    ~ProgressSource();                     // cancels the linked runs silently
+    ProgressSource(const ProgressSource&) = delete;
+    ProgressSource& operator=(const ProgressSource&) = delete;
+
+    void   Set(double v);                  // steps the linked runs if v changed
+    double Get() const                     { return value; }
+    ProgressSource& Range(double lo, double hi); // value span of the timeline
+    double GetProgress() const;            // value over the range, [0..1]
+    int    GetLinkCount() const;           // live linked runs
+
+private:
+    double value = 0, lo = 0, hi = 1;
+    Vector<AnimHandle> runs;               // linked runs; dead handles pruned by Set()
+    int    depth = 0;                      // Set() nesting (ticks may Set again)
+
+    void   StepRuns();
+    friend class Animation;
 };
 
 /*---------------- Convenience helpers for animating values --------------------
-   AnimateValue<T>: builds a one-shot animation that lerps from 'from' to 'to'
-   using the provided setter (Event<const T&>), refreshing the control each frame.
+   ValueTraits<T> maps a value type to N double components (specialize it
+   for your own types). ValueTrack<T> is the tick of a value run: it sets
+   from + (to - from) * e and remembers the value set last, which is where
+   a superseding run starts. Retarget() turns the path into a Hermite
+   blend from the current value and velocity to the new target; it needs
+   the component view. Types without one are lerped with +, - and *.
 -----------------------------------------------------------------------------*/
+template <class T, class = void>
+struct ValueTraits {};                     // no component view: lerp fallback
+
 template <class T>
-inline Animation AnimateValue(Ctrl& ctrl, Event<const T&> set, T from, T to,
-                              int ms, Easing::Fn ease = Easing::InOutCubic())
-{
-    Animation a(ctrl);
-    a([ctrlPtr = Ptr<Ctrl>(&ctrl), set, from, to](double p) -> bool {
-        if(!ctrlPtr) return false;
-        if constexpr(std::is_same_v<T, Color>)
-            set(Blend(from, to, int(255 * p)));
-        else if constexpr(std::is_same_v<T, Point>)
-            set(Point(int(from.x + (to.x - from.x) * p + .5),
-                      int(from.y + (to.y - from.y) * p + .5)));
-        else if constexpr(std::is_same_v<T, Size>)
-            set(Size(int(from.cx + (to.cx - from.cx) * p + .5),
-                     int(from.cy + (to.cy - from.cy) * p + .5)));
-        else if constexpr(std::is_same_v<T, Rect>)
-            set(Rect(Point(int(from.left + (to.left - from.left) * p + .5),
-                           int(from.top  + (to.top  - from.top ) * p + .5)),
-                     Size(int(from.Width()  + (to.Width()  - from.Width() ) * p + .5),
-                          int(from.Height() + (to.Height() - from.Height()) * p + .5))));
-        else
-            set(from + (to - from) * p);
-        ctrlPtr->Refresh();
+struct ValueTraits<T, std::enable_if_t<std::is_arithmetic<T>::value>> { // arithmetic types
+    enum { N = 1 };
+    static void Get(const T& v, double *c) { c[0] = double(v); }
+    static T    Set(const double *c)       { return T(c[0]); }
+};
+
+template <>
+struct ValueTraits<Color> {
+    enum { N = 3 };
+    static void  Get(Color v, double *c)   { c[0] = v.GetR(); c[1] = v.GetG(); c[2] = v.GetB(); }
+    static Color Set(const double *c)      { return Color(Channel(c[0]), Channel(c[1]), Channel(c[2])); }
+    static int   Channel(double x)         { return clamp(int(floor(x + .5)), 0, 255); }
+};
+
+template <>
+struct ValueTraits<Point> {
+    enum { N = 2 };
+    static void  Get(Point v, double *c)   { c[0] = v.x; c[1] = v.y; }
+    static Point Set(const double *c)      { return Point(int(floor(c[0] + .5)), int(floor(c[1] + .5))); }
+};
+
+template <>
+struct ValueTraits<Pointf> {
+    enum { N = 2 };
+    static void   Get(Pointf v, double *c) { c[0] = v.x; c[1] = v.y; }
+    static Pointf Set(const double *c)     { return Pointf(c[0], c[1]); }
+};
+
+template <>
+struct ValueTraits<Size> {
+    enum { N = 2 };
+    static void Get(Size v, double *c)     { c[0] = v.cx; c[1] = v.cy; }
+    static Size Set(const double *c)       { return Size(int(floor(c[0] + .5)), int(floor(c[1] + .5))); }
+};
+
+template <>
+struct ValueTraits<Rect> {                 // left, top, width, height
+    enum { N = 4 };
+    static void Get(const Rect& v, double *c) { c[0] = v.left; c[1] = v.top; c[2] = v.Width(); c[3] = v.Height(); }
+    static Rect Set(const double *c)       { return Rect(ValueTraits<Point>::Set(c), ValueTraits<Size>::Set(c + 2)); }
+};
+
+template <class T, class>
+struct HasValueComponents : std::false_type {};
+
+template <class T>
+struct HasValueComponents<T, std::void_t<decltype(ValueTraits<T>::N)>> : std::true_type {};
+
+template <class T, bool>
+struct ValueTrack {                        // lerp: from + (to - from) * e; no Retarget()
+    Ptr<Ctrl>       ctrl;
+    Event<const T&> set;
+    T               value;                 // value set last
+    T               from, to;
+
+    ValueTrack(Ctrl& c, Event<const T&> set, const T& a, const T& b)
+        : ctrl(&c), set(pick(set)), value(a), from(a), to(b) {}
+
+    bool operator()(double p) {
+        if (!ctrl) return false;
+        value = from + (to - from) * p;
+        set(value);
+        ctrl->Refresh();
+        return true;
+    }
+};
+
+template <class T>
+struct ValueTrack<T, true> {
+    typedef ValueTraits<T> Traits;
+    enum { N = Traits::N };
+
+    Ptr<Ctrl>       ctrl;
+    Event<const T&> set;
+    T               value;                 // value set last
+    double          from[N], delta[N];     // path: from + delta * E(s) + kick * s(1-s)^2
+    double          kick[N] = {};
+    Easing::Fn      ease;                  // E once shaped; the run itself is then linear
+    bool            shaped = false;        // ticks get raw time progress (after Retarget)
+
+    ValueTrack(Ctrl& c, Event<const T&> set, const T& a, const T& b)
+        : ctrl(&c), set(pick(set)), value(a) {
+        Traits::Get(a, from);
+        Traits::Get(b, delta);
+        for (int i = 0; i < N; ++i) delta[i] -= from[i];
+    }
+
+    bool operator()(double p) {
+        if (!ctrl) return false;
+        double x[N];
+        Eval(p, x, nullptr);
+        value = Traits::Set(x);
+        set(value);
+        ctrl->Refresh();
         return true;
-    })
-    .Duration(ms)
-    .Ease(ease)
-    .Play();
-    return pick(a);
+    }
+
+    // Components (and their slope per unit of progress) at progress s.
+    void Eval(double s, double *x, double *dx) const {
+        const double e = shaped ? Ease(s) : s;
+        const double g = s * (1 - s) * (1 - s);
+        for (int i = 0; i < N; ++i)
+            x[i] = from[i] + delta[i] * e + kick[i] * g;
+        if (dx) {
+            const double de = shaped ? Slope(s) : 1;
+            const double dg = (1 - s) * (1 - 3 * s);
+            for (int i = 0; i < N; ++i)
+                dx[i] = delta[i] * de + kick[i] * dg;
+        }
+    }
+
+    // Restart the path at time progress s of a run lasting old_ms: it now
+    // starts at the current value and lasts new_ms. keep_velocity adds a
+    // Hermite term so the value's rate (per ms) is continuous; otherwise
+    // the new leg starts at rest. 'run_ease' is the run's easing, taken over
+    // on the first retarget (the run then feeds raw progress). 'backward':
+    // the run was moving s towards 0 (a yoyo's return leg).
+    void Retarget(const T& to, double s, double old_ms, double new_ms,
+                  bool keep_velocity, Easing::Fn& run_ease, bool backward = false) {
+        double x[N], dx[N], tgt[N];
+        if (!shaped) {
+            for (int i = 0; i < N; ++i) {  // unshaped: e(s) = run_ease(s)
+                const double e = run_ease ? run_ease(s) : s;
+                x[i] = from[i] + delta[i] * e;
+            }
+            ease   = pick(run_ease);
+            run_ease.Clear();
+            shaped = true;
+            const double de = Slope(s);
+            for (int i = 0; i < N; ++i)
+                dx[i] = delta[i] * de;
+        }
+        else
+            Eval(s, x, dx);
+        Traits::Get(to, tgt);
+        const double e0   = Slope(0);
+        const double rate = (backward ? -new_ms : new_ms) / max(old_ms, 1.0);
+        for (int i = 0; i < N; ++i) {
+            from[i]  = x[i];
+            delta[i] = tgt[i] - x[i];
+            kick[i]  = keep_velocity ? dx[i] * rate - delta[i] * e0 : 0;
+        }
+    }
+
+    double Ease(double s) const            { return ease ? ease(s) : s; }
+    double Slope(double s) const {         // central difference, wide enough for Bezier presets
+        const double h = 1.0 / 32;
+        const double a = max(0.0, s - h), b = min(1.0, s + h);
+        return (Ease(b) - Ease(a)) / (b - a);
+    }
+};
+
+template <class T>
+bool AnimHandle::Retarget(const T& to, int mode)
+{
+    static_assert(HasValueComponents<T>::value, "Retarget() needs a ValueTraits<T> component view");
+    Animation::State* s = Animation::Scheduler::Resolve(*this);
+    if (!s || s->spec->kind != Animation::RUN_TWEEN || !s->spec->tick.template Target<ValueTrack<T>>())
+        return false;
+    Animation::Staging& w = s->spec.Write();  // copies only a shared spec (once)
+    const int64  now  = s->sched->FrameTime();
+    int64 leg = 0;                            // path position from the current leg
+    const double p    = s->linked ? s->Progress(now) : s->LegProgress(max<int64>(0, s->RunTime(now)), leg);
+    const bool   back = w.yoyo && (leg & 1);
+    const double u    = back ? 1 - p : p;
+    const double old  = max(1, w.duration_ms);
+    const double dur  = mode == Animation::RETARGET_KEEP_END ? max(1.0, old * (1 - p)) : old;
+    w.tick.template Target<ValueTrack<T>>()->Retarget(to, u, old, dur,
+                                            mode != Animation::RETARGET_RESTART, w.easing, back);
+    w.duration_ms = int(dur + .5);
+    w.delay_ms    = 0;
+    w.loop_count  = 1;
+    w.yoyo        = false;
+    s->start_ms   = now;
+    s->elapsed_ms = 0;
+    s->leg        = 0;
+    s->reverse    = false;
+    s->due_ms     = 0;
+    return true;
 }
 
-inline Animation AnimateColor(Ctrl& c, Event<const Color&> cb, Color f, Color t,
-                              int ms, Easing::Fn e = Easing::InOutCubic())
+/*---------------- AnimateValue ------------------------------------------------
+   Launches a fire-and-forget run that lerps from 'from' to 'to' using the
+   provided setter (Event<const T&>), refreshing the control each frame. The
+   returned handle may be ignored or kept to control the run.
+   With a property id (prop != 0) the run is keyed by (ctrl, prop): a run
+   still animating that property is superseded, and 'from' is replaced by
+   the value it set last, so back-and-forth input keeps one run per property
+   and never jumps.
+-----------------------------------------------------------------------------*/
+template <class T>
+inline AnimHandle AnimateValue(Ctrl& ctrl, int prop, Event<const T&> set, T from, T to,
+                               int ms, Easing::Fn ease = Easing::InOutCubic())
+{
+    Animation::Scheduler& sched = Animation::Scheduler::Default();
+    if (prop)
+        if (const ValueTrack<T>* cur = sched.FindPropertyTick<ValueTrack<T>>(ctrl, prop))
+            from = cur->value;
+    Animation::Staging spec;
+    spec.duration_ms = ms;
+    spec.easing      = pick(ease);
+    spec.tick        = ValueTrack<T>(ctrl, pick(set), from, to);
+    return sched.Launch(ctrl, pick(spec), prop);
+}
+
+template <class T>
+inline AnimHandle AnimateValue(Ctrl& ctrl, Event<const T&> set, T from, T to,
+                               int ms, Easing::Fn ease = Easing::InOutCubic())
+{ return AnimateValue<T>(ctrl, 0, pick(set), from, to, ms, pick(ease)); }
+
+inline AnimHandle AnimateColor(Ctrl& c, Event<const Color&> cb, Color f, Color t,
+                               int ms, Easing::Fn e = Easing::InOutCubic())
 { return AnimateValue<Color>(c, cb, f, t, ms, e); }
 
-inline Animation AnimateRect (Ctrl& c, Event<const Rect&>  cb, Rect  f, Rect  t,
-                              int ms, Easing::Fn e = Easing::InOutCubic())
+inline AnimHandle AnimateRect (Ctrl& c, Event<const Rect&>  cb, Rect  f, Rect  t,
+                               int ms, Easing::Fn e = Easing::InOutCubic())
 { return AnimateValue<Rect>(c, cb, f, t, ms, e); }
 
+// Property-keyed variants (see AnimateValue).
+inline AnimHandle AnimateColor(Ctrl& c, int prop, Event<const Color&> cb, Color f, Color t,
+                               int ms, Easing::Fn e = Easing::InOutCubic())
+{ return AnimateValue<Color>(c, prop, cb, f, t, ms, e); }
+
+inline AnimHandle AnimateRect (Ctrl& c, int prop, Event<const Rect&>  cb, Rect  f, Rect  t,
+                               int ms, Easing::Fn e = Easing::InOutCubic())
+{ return AnimateValue<Rect>(c, prop, cb, f, t, ms, e); }
+
 } // namespace Upp
 
 #endif // _Animation_Animation_h_
@@ -5,7 +5,7 @@
     ------------
     A self-contained console test suite for the Animation library that:
       • Never opens any window (no GUI subsystem needed).
-      • Drives frames with Animation::TickOnce() for deterministic timing.
+      • Drives frames on a virtual clock (AdvanceTime), never sleeping.
       • Uses a plain Ctrl only as an *owner* (never opened).
       • Prints clear PASS/FAIL lines per test and a summary.
 
@@ -28,12 +28,14 @@ using namespace Upp;
 #include "ConsoleAnim.h"
 
 // ---------- deterministic time driver (no GUI pump) ----------
+// 1 ms frames of simulated time: no sleeping, same result on any machine.
 static void PumpForMs(int ms) {
-    int64 until = msecs() + ms;
-    while (msecs() < until) {
-        Animation::TickOnce();   // advance scheduler deterministically
-        Sleep(1);
-    }
+    Animation::AdvanceTime(ms, 1);
+}
+
+// Same, for a specific scheduler instance.
+static void PumpForMs(Animation::Scheduler& sched, int ms) {
+    sched.AdvanceTime(ms, 1);
 }
 
 // ---------- shared fixtures ----------
@@ -204,14 +206,14 @@ static bool L14_cancel_calls_cancel_only(Probe& p) {
 // L15 — Start Delay is respected (no ticks before delay)
 static bool L15_delay_respected(Probe& p) {
     int ticks=0;
-    int64 start = msecs();
+    int64 start = Animation::FrameTime();
     Animation a(p.owner);
     a([&](double){ ++ticks; return true; })
       .Delay(120).Duration(60).Play();
     PumpForMs(80);
     bool pre_ok = (ticks == 0);
     PumpForMs(80);
-    bool post_ok = (ticks > 0) && (msecs() - start >= 120);
+    bool post_ok = (ticks > 0) && (Animation::FrameTime() - start >= 120);
     Cout() << "L15: delay respected\n";
     return pre_ok && post_ok;
 }
@@ -491,6 +493,889 @@ static bool L32_replay_interrupts_running(Probe& p) {
     return hits > 0; // just prove the restarted run is ticking
 }
 
+// L33 — SetMaxActive evicts the oldest run, completing it like Stop()
+static bool L33_max_active_evicts_oldest(Probe& p) {
+    bool fin1=false, fin2=false, fin3=false;
+    BoolFlag f1{&fin1}, f2{&fin2}, f3{&fin3};
+    double last1 = 0.0;
+    Animation::SetMaxActive(2, Animation::CAP_EVICT_OLDEST);
+    Animation a(p.owner), b(p.owner), c(p.owner);
+    a([&](double e){ last1 = e; return true; })
+      .OnFinish(callback(&f1, &BoolFlag::Set)).Duration(300).Play();
+    b([](double){ return true; }).OnFinish(callback(&f2, &BoolFlag::Set)).Duration(300).Play();
+    c([](double){ return true; }).OnFinish(callback(&f3, &BoolFlag::Set)).Duration(300).Play();
+    bool evicted = fin1 && !a.IsPlaying() && a.Progress() >= 1.0 && last1 >= 1.0;
+    bool kept    = !fin2 && !fin3 && b.IsPlaying() && c.IsPlaying();
+    Animation::SetMaxActive(0);
+    Cout() << "L33: cap evicts oldest\n";
+    return evicted && kept;
+}
+
+// L34 — CAP_REJECT_NEW refuses low-priority newcomers, admits higher ones
+static bool L34_max_active_rejects_low_priority(Probe& p) {
+    bool finlow=false; BoolFlag fl{&finlow};
+    Animation::SetMaxActive(2, Animation::CAP_REJECT_NEW);
+    Animation a(p.owner), b(p.owner), low(p.owner), high(p.owner);
+    a([](double){ return true; }).Priority(1).Duration(300).Play();
+    b([](double){ return true; }).Priority(2).Duration(300).Play();
+    low([](double){ return true; }).OnFinish(callback(&fl, &BoolFlag::Set))
+       .Priority(0).Duration(300).Play();
+    bool rejected = finlow && !low.IsPlaying();
+    high([](double){ return true; }).Priority(5).Duration(300).Play();
+    bool admitted = high.IsPlaying() && !a.IsPlaying() && b.IsPlaying();
+    Animation::SetMaxActive(0);
+    Cout() << "L34: cap rejects low priority\n";
+    return rejected && admitted;
+}
+
+// L35 — A private scheduler drives its own runs independently of the default
+static bool L35_private_scheduler(Probe& p) {
+    int ticks = 0;
+    bool finished = false; BoolFlag onfin{&finished};
+    Animation::Scheduler sched;
+    sched.SetFPS(30);
+    Animation a(p.owner, sched);
+    a([&](double){ ++ticks; return true; })
+      .OnFinish(callback(&onfin, &BoolFlag::Set)).Duration(60).Play();
+    PumpForMs(40);                          // default scheduler: must not step it
+    bool isolated = (ticks == 0) && sched.GetCount() == 1
+                 && Animation::GetFPS() != 30 && sched.GetFPS() == 30;
+    PumpForMs(sched, 120);
+    Cout() << Format("L35: private scheduler ticks=%d\n", ticks);
+    return isolated && ticks > 0 && finished;
+}
+
+// L36 — Suspend() freezes a scheduler's clock; Resume() continues in place
+static bool L36_suspend_resume_scheduler(Probe& p) {
+    Animation::Scheduler sched;
+    Animation a(p.owner, sched);
+    a([](double){ return true; }).Duration(200).Play();
+    PumpForMs(sched, 40);
+    sched.Suspend();
+    double at_suspend = a.Progress();
+    PumpForMs(sched, 80);                   // ticks are no-ops while suspended
+    bool frozen = sched.IsSuspended() && fabs(a.Progress() - at_suspend) < 1e-9;
+    sched.Resume();
+    PumpForMs(sched, 40);
+    bool continued = a.IsPlaying() && a.Progress() > at_suspend && a.Progress() < 0.9;
+    Cout() << Format("L36: suspended at %.3f\n", at_suspend);
+    return frozen && continued;
+}
+
+// L37 — Culled owners (never opened) skip ticks but keep time and finish
+static bool L37_visibility_culling(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetCulling(true, 10);
+    int ticks = 0; double last = -1.0;
+    bool finished = false; BoolFlag onfin{&finished};
+    Animation a(p.owner, sched);
+    a([&](double e){ ++ticks; last = e; return true; })
+      .OnFinish(callback(&onfin, &BoolFlag::Set)).Duration(60).Play();
+    PumpForMs(sched, 120);
+    bool final_only = finished && ticks == 1 && last >= 1.0;
+
+    // Un-culling mid-run delivers the current (caught-up) value at once.
+    ticks = 0; last = -1.0;
+    a([&](double e){ ++ticks; last = e; return true; }).Duration(200).Play();
+    PumpForMs(sched, 80);
+    bool silent = (ticks == 0);
+    sched.SetCulling(false);
+    sched.Tick();
+    bool caught_up = ticks == 1 && last > 0.05;
+    Cout() << Format("L37: culled, catch-up e=%.3f\n", last);
+    return final_only && silent && caught_up;
+}
+
+// L38 — Batch keeps the timer armed across Cancel→Play; idle grace expires
+static bool L38_batch_and_idle_grace(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetIdleGrace(0);
+    Animation a(p.owner, sched), b(p.owner, sched);
+    a([](double){ return true; }).Duration(200).Play();
+    bool kept = false;
+    {
+        Animation::Batch batch(sched);
+        a.Cancel();                          // would disarm without the batch
+        kept = sched.IsRunning();
+        b([](double){ return true; }).Duration(200).Play();
+    }
+    bool batched = kept && sched.IsRunning() && b.IsPlaying() && !a.IsPlaying();
+
+    sched.SetIdleGrace(40);
+    b.Cancel();
+    bool in_grace = sched.IsRunning();       // still armed right after emptying
+    PumpForMs(sched, 80);
+    bool expired = !sched.IsRunning();
+    Cout() << "L38: batch + idle grace\n";
+    return batched && in_grace && expired;
+}
+
+// L39 — A stall spanning several legs resolves in one frame (OnLeg reports skips)
+static bool L39_stall_catch_up(Probe& p) {
+    Animation::Scheduler sched;
+    int skipped = -1, legs = 0, frames = 0;
+    double last = -1.0;
+    bool finished = false; BoolFlag onfin{&finished};
+    Animation a(p.owner, sched);
+    a([&](double e){ ++frames; last = e; return true; })
+      .OnLeg([&](int n){ ++legs; skipped = n; })
+      .OnFinish(callback(&onfin, &BoolFlag::Set))
+      .Ease(Easing::Linear()).Loop(6).Duration(50).Play();
+    sched.Tick();
+    sched.AdvanceTime(180, 180);             // stall: 3.6 legs in one frame
+    bool jumped = legs == 1 && skipped >= 2 && !finished;
+    frames = 0;
+    sched.AdvanceTime(200, 200);             // past the end of leg 6
+    bool done = finished && frames == 1 && last >= 1.0;
+    Cout() << Format("L39: skipped=%d legs=%d\n", skipped, legs);
+    return jumped && done;
+}
+
+// L40 — Fixed-step mode yields identical sim values at any frame rate
+static bool L40_fixed_step_frame_rate_independent(Probe& p) {
+    auto run = [&](int frame_ms, Vector<double>& seen, bool& alpha_ok) {
+        Animation::Scheduler sched;
+        sched.SetFixedStep(100);            // 10 ms simulation steps
+        Animation a(p.owner, sched);
+        a([&](double e){ seen.Add(e); return true; })
+          .OnRender([&](double alpha){ if (alpha < 0.0 || alpha >= 1.0) alpha_ok = false; })
+          .Ease(Easing::Linear()).Duration(100).Play();
+        for (int guard = 0; a.IsPlaying() && guard < 1000; ++guard)
+            sched.AdvanceTime(frame_ms, frame_ms);
+    };
+    Vector<double> fast, slow;
+    bool alpha_ok = true;
+    run(1, fast, alpha_ok);
+    run(23, slow, alpha_ok);
+    bool same = fast.GetCount() == slow.GetCount() && fast.GetCount() == 10;
+    for (int i = 0; same && i < fast.GetCount(); ++i)
+        same = fabs(fast[i] - slow[i]) < 1e-9;
+    Cout() << Format("L40: fixed-step values fast=%d slow=%d\n", fast.GetCount(), slow.GetCount());
+    return same && alpha_ok;
+}
+
+// L41 — MaxRate() throttles a run to its rate group but still finishes on time
+static bool L41_max_rate_groups(Probe& p) {
+    Animation::Scheduler sched;
+    int slow = 0, fast = 0;
+    double last = -1.0;
+    bool finished = false; BoolFlag onfin{&finished};
+    Animation a(p.owner, sched), b(p.owner, sched);
+    a([&](double e){ ++slow; last = e; return true; })
+      .OnFinish(callback(&onfin, &BoolFlag::Set)).MaxRate(20).Duration(200).Play();
+    b([&](double){ ++fast; return true; }).Duration(200).Play();
+    PumpForMs(sched, 260);
+    Cout() << Format("L41: 20 Hz ticks=%d, full-rate ticks=%d\n", slow, fast);
+    return finished && last >= 1.0 && slow >= 3 && slow <= 7 && fast > 2 * slow;
+}
+
+// L42 — Auto-FPS governor backs off under sustained overload and recovers
+static bool L42_auto_fps_governor(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetFPS(60);
+    sched.SetAutoFPS(true, 15);
+    bool heavy = true;
+    Animation a(p.owner, sched);
+    a([&](double){
+        if (heavy) { int64 t = usecs(); while (usecs() - t < 15000) {} } // ~15 ms frame
+        return true;
+    }).Loop(-1).Duration(100).Play();
+    for (int i = 0; i < 40; ++i) sched.Tick();
+    int lowered = sched.GetEffectiveFPS();
+    heavy = false;
+    for (int i = 0; i < 600 && sched.GetEffectiveFPS() < 60; ++i) { Sleep(1); sched.Tick(); }
+    int recovered = sched.GetEffectiveFPS();
+    a.Cancel();
+    Cout() << Format("L42: effective FPS 60 -> %d -> %d\n", lowered, recovered);
+    return lowered < 60 && lowered >= 15 && recovered == 60;
+}
+
+// L43 — Frame source switch (timerfd on Linux) + jitter histogram math
+static bool L43_frame_source(Probe&) {
+    typedef Animation::Scheduler S;
+    S sched;
+    bool fd = sched.SetFrameSource(S::FRAME_TIMERFD);
+#ifdef PLATFORM_LINUX
+    bool src_ok = fd && sched.GetFrameSource() == S::FRAME_TIMERFD;
+#else
+    bool src_ok = !fd && sched.GetFrameSource() == S::FRAME_TIMER;
+#endif
+    bool back = sched.SetFrameSource(S::FRAME_TIMER) && sched.GetFrameSource() == S::FRAME_TIMER;
+
+    S::FrameStats st;                      // 98 frames within 250 us, 2 at ~1.1 ms
+    st.frames = 100;
+    st.hist[0] = 98;
+    st.hist[4] = 2;
+    st.max_us = 1100;
+    int p50 = st.Percentile(0.5), p99 = st.Percentile(0.99);
+    bool empty = sched.GetFrameStats().frames == 0;
+    Cout() << Format("L43: timerfd %s, p50 <= %d us, p99 <= %d us\n", fd ? "on" : "n/a", p50, p99);
+    return src_ok && back && p50 == 250 && p99 == 1250 && empty;
+}
+
+// L44 — Immediate(): t=0 frame delivered inside Play(); scheduler default
+static bool L44_immediate_first_frame(Probe& p) {
+    Animation::Scheduler sched;
+    int n1 = 0; double e1 = -1;
+    Animation a(p.owner, sched);
+    a([&](double e){ ++n1; e1 = e; return true; }).Duration(200).Immediate().Play();
+    bool first = n1 == 1 && e1 == 0.0 && a.IsPlaying();
+
+    int n2 = 0;                            // default off: nothing until a frame
+    Animation b(p.owner, sched);
+    b([&](double){ ++n2; return true; }).Duration(200).Play();
+    bool deferred = n2 == 0;
+
+    sched.SetImmediate(true);              // scheduler default; tick ends the run at once
+    int n3 = 0;
+    Animation c(p.owner, sched);
+    c([&](double){ ++n3; return false; }).Duration(200).Play();
+    bool ended = n3 == 1 && !c.IsPlaying() && sched.GetCount() == 2;
+
+    a.Cancel(); b.Cancel();
+    Cout() << Format("L44: immediate ticks %d/%d/%d, running %d\n", n1, n2, n3, sched.GetCount());
+    return first && deferred && ended;
+}
+
+// L45 — FrameTime(): shared start within an event; Progress() matches the frame
+static bool L45_frame_time(Probe& p) {
+    Animation::Scheduler sched;
+    auto lin = [](double t){ return t; };
+    double ea = -1, eb = -1;
+    Animation a(p.owner, sched), b(p.owner, sched);
+    a([&](double e){ ea = e; return true; }).Duration(400).Ease(lin).Play();
+    Sleep(5);                              // same event: b snaps to a's start
+    b([&](double e){ eb = e; return true; }).Duration(400).Ease(lin).Play();
+    Sleep(40);
+    sched.Tick();
+    bool lockstep = ea > 0 && ea == eb;
+    Sleep(30);                             // no frame: Progress() keeps the frame's value
+    bool consistent = a.Progress() == ea && sched.FrameTime() == sched.FrameTime();
+    a.Cancel(); b.Cancel();
+    Cout() << Format("L45: a=%.3f b=%.3f progress=%.3f\n", ea, eb, a.Progress());
+    return lockstep && consistent;
+}
+
+// L46 — OnFrame(): hooks share the frame timestamp, unsubscribe, die with owner
+static bool L46_frame_hooks(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetIdleGrace(0);
+    int64 run_now = -1;
+    bool same_ts = true;
+    int calls = 0;
+    double dt_sum = 0;
+    int64 t0 = sched.FrameTime();
+    sched.OnFrame(p.owner, [&](int64 now, double dt){
+        same_ts = same_ts && now == sched.FrameTime();
+        dt_sum += dt;
+        return ++calls < 3;                // unsubscribe after 3 frames
+    });
+    int counted = 0;
+    int id = sched.OnFrame(p.owner, [&](int64, double){ ++counted; return true; });
+    One<Ctrl> tmp;
+    tmp.Create();
+    int dead = 0;
+    sched.OnFrame(*tmp, [&](int64, double){ ++dead; return true; });
+    bool armed = sched.IsRunning();
+
+    Animation a(p.owner, sched);
+    a([&](double){ run_now = sched.FrameTime(); return true; }).Duration(1000).Play();
+    for (int i = 0; i < 4; ++i) sched.AdvanceTime(5, 5);
+    tmp.Clear();                           // owner dies → hook dropped
+    sched.Tick();
+    bool lockstep = same_ts && run_now == sched.FrameTime();
+    bool dt_ok = int64(dt_sum + 0.5) >= 15 && int64(dt_sum + 0.5) <= sched.FrameTime() - t0;
+    sched.CancelFrame(id);
+    a.Cancel();
+    bool idle = sched.GetFrameHookCount() == 0 && !sched.IsRunning();
+    Cout() << Format("L46: hook calls=%d counted=%d dead-owner=%d\n", calls, counted, dead);
+    return armed && lockstep && calls == 3 && counted == 5 && dead == 4 && dt_ok && idle;
+}
+
+// L47 — Motion modes: Instant completes in Play() and snaps runs in flight;
+//        Reduced shortens new runs
+static bool L47_motion_mode(Probe& p) {
+    Animation::Scheduler sched;
+    double last = -1; bool fin = false;
+    Animation a(p.owner, sched);
+    Animation::SetMotionMode(Animation::MOTION_INSTANT);
+    a([&](double e){ last = e; return true; }).Duration(5000).OnFinish([&]{ fin = true; }).Play();
+    bool instant = last == 1.0 && fin && !a.IsPlaying() && !sched.IsRunning() && a.Progress() == 1.0;
+
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    double yo = -1; bool yfin = false;
+    Animation b(p.owner, sched);
+    b([&](double e){ yo = e; return true; }).Duration(5000).Yoyo().OnFinish([&]{ yfin = true; }).Play();
+    sched.Tick();
+    Animation::SetMotionMode(Animation::MOTION_INSTANT); // snap in flight
+    bool snapped = yfin && yo == 0.0 && sched.GetCount() == 0;
+
+    Animation::SetMotionMode(Animation::MOTION_REDUCED);
+    Animation c(p.owner, sched);
+    c([](double){ return true; }).Duration(400).Play();
+    sched.AdvanceTime(120, 120);
+    bool reduced = !c.IsPlaying() && c.Progress() == 1.0;
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    Cout() << Format("L47: instant=%d snapped=%d reduced=%d\n", (int)instant, (int)snapped, (int)reduced);
+    return instant && snapped && reduced;
+}
+
+// L48 — PlayMany(): shared spec, per-item ticks from a factory, stagger
+static bool L48_play_many(Probe&) {
+    Animation::Scheduler sched;
+    Array<Ctrl> rows;
+    Vector<Ctrl*> owners;
+    for (int i = 0; i < 40; ++i)
+        owners.Add(&rows.Add());
+    Vector<double> val;
+    val.SetCount(40, -1.0);
+    int started = 0;
+
+    Animation::Staging spec;
+    spec.duration_ms = 200;
+    spec.easing = [](double t){ return t; };
+    spec.on_start = [&]{ ++started; };
+    sched.PlayMany(owners, spec, [&](int i, Ctrl&) -> Function<bool(double)> {
+        return [&val, i](double e){ val[i] = e; return true; };
+    }, 10);
+    bool all = sched.GetCount() == 40 && started == 40 && sched.IsRunning();
+
+    sched.AdvanceTime(60, 60);
+    bool stagger = val[0] > val[3] && val[3] > 0 && val[39] == -1.0; // row 39 starts at +390 ms
+    PumpForMs(sched, 700);
+    bool done = sched.GetCount() == 0 && val[0] == 1.0 && val[39] == 1.0;
+    Cout() << Format("L48: rows=%d first=%.2f last=%.2f\n", owners.GetCount(), val[0], val[39]);
+    return all && stagger && done;
+}
+
+// L49 — Copy-on-write specs: run, last_spec_ and Replay() share one copy
+static bool L49_shared_specs(Probe& p) {
+    Animation::Scheduler sched;
+    int hits = 0;
+    Animation a(p.owner, sched);
+    a([&](double){ ++hits; return true; }).Duration(300).Loop(2).Play();
+    const Animation::Staging* spec = &*a.GetLastSpec();
+    bool shared = a.GetLastSpec().GetRefCount() == 2;       // run + last_spec_
+    a.Replay();
+    a.Replay();
+    bool reused = &*a.GetLastSpec() == spec && a.GetLastSpec().GetRefCount() == 2;
+    sched.Tick();
+
+    a.Duration(100);                                        // new staging; last spec untouched
+    bool intact = a.GetLastSpec()->duration_ms == 300 && a.GetLastSpec()->loop_count == 2;
+
+    Animation::SetMotionMode(Animation::MOTION_REDUCED);    // run gets a private copy
+    Animation b(p.owner, sched);
+    b([](double){ return true; }).Duration(400).Play();
+    bool cow = b.GetLastSpec()->duration_ms == 400 && b.GetLastSpec().GetRefCount() == 1;
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    a.Cancel(); b.Cancel();
+    bool released = a.GetLastSpec().GetRefCount() == 1;
+    Cout() << Format("L49: shared=%d reused=%d cow=%d hits=%d\n", (int)shared, (int)reused, (int)cow, hits);
+    return shared && reused && intact && cow && released && hits > 0;
+}
+
+// L50 — Idle Animations share the default spec; the first setter clones it
+static bool L50_default_spec_shared(Probe& p) {
+    Animation::Scheduler sched;
+    Array<Animation> idle;
+    for (int i = 0; i < 1000; ++i)
+        idle.Add(new Animation(p.owner, sched));  // no staging allocation each
+
+    Animation a(p.owner, sched), b(p.owner, sched), c(p.owner, sched);
+    a.Duration(50);                                // clones; b/c keep defaults
+    a([](double){ return true; }).Play();
+    b([](double){ return true; }).Play();
+    c.Play();                                      // untouched default: shared
+    bool isolated = a.GetLastSpec()->duration_ms == 50 && b.GetLastSpec()->duration_ms == 400;
+    bool shared   = c.GetLastSpec().GetRefCount() >= 3 + 1000; // default + idle + run + last
+    c.Reset();
+    a.Cancel(); b.Cancel(); c.Cancel();
+    Cout() << Format("L50: default spec refs=%d\n", c.GetLastSpec().GetRefCount());
+    return isolated && shared;
+}
+
+// L51 — SmallFunction: typical hooks and member delegates stay inline
+namespace {
+struct HookSink {
+    int finished = 0;
+    void Finish() { ++finished; }
+};
+}
+
+static bool L51_small_function_hooks(Probe& p) {
+    Animation::Scheduler sched;
+    HookSink sink;
+    int starts = 0, frames = 0;
+    double last = -1;
+    SmallEvent<>       start([&starts, &sink] { ++starts; });
+    SmallEvent<double> update([&last, &frames, &sink](double v) { last = v; ++frames; });
+    SmallEvent<>       finish(&sink, &HookSink::Finish);
+    struct Big { double v[8]; } big = {};
+    SmallFunction<bool(double)> heavy([big](double) { return big.v[0] == 0; });
+    bool inline_ok = start.IsInline() && update.IsInline() && finish.IsInline() && !heavy.IsInline();
+
+    SmallEvent<> empty = Event<>();                 // empty Function<> stays empty
+    SmallEvent<> copied = finish;                   // copy keeps the delegate inline
+    bool empties = !empty && copied.IsInline();
+    empty();                                        // calling empty is a no-op
+
+    Animation a(p.owner, sched);
+    a(pick(heavy)).Duration(20).OnStart(pick(start)).OnUpdate(pick(update)).OnFinish(pick(finish)).Play();
+    PumpForMs(sched, 80);
+    bool fired = starts == 1 && sink.finished == 1 && frames > 0 && last == 1.0;
+    Cout() << Format("L51: inline=%d frames=%d finished=%d\n", (int)inline_ok, frames, sink.finished);
+    return inline_ok && empties && fired;
+}
+
+// L52 — Generational handles: Animations move explicitly, dead handles are inert
+static bool L52_generational_handles(Probe& p) {
+    Animation::Scheduler sched;
+    Array<Animation> row;                          // never Vector: slots point back at them
+    for (int i = 0; i < 64; ++i) {
+        row.Add(new Animation(p.owner, sched));
+        row.Top()([](double){ return true; }).Duration(20).Play();
+    }
+    Animation last(pick(row.Top()));               // explicit move mid-run: the run follows
+    bool moved = last.IsPlaying() && !row.Top().IsPlaying();
+    PumpForMs(sched, 60);
+    for (int i = 0; i < 63; ++i)
+        moved = moved && !row[i].IsPlaying() && row[i].Progress() == 1.0;
+    moved = moved && last.Progress() == 1.0;
+
+    AnimHandle h = row[0].GetHandle();             // dead: finished
+    h.Cancel(); h.Stop(); h.Pause();               // all O(1) no-ops
+    bool dead = !h.IsAlive() && h.Progress() == 0.0;
+
+    double v = 0;                                  // fire-and-forget, no Animation object
+    AnimHandle f = AnimateValue<double>(p.owner, [&v](const double& x) { v = x; }, 0.0, 10.0, 20);
+    Vector<AnimHandle> hs;
+    for (int i = 0; i < 8; ++i) {
+        Animation::Staging spec;
+        spec.duration_ms = 1000;
+        hs.Add(sched.Launch(p.owner, pick(spec)));
+    }
+    hs[0].Cancel();
+    AnimHandle reused = sched.Launch(p.owner, Animation::Staging());
+    bool stale = !hs[0].IsAlive() && reused.IsAlive() && reused != hs[0] && hs[1].IsAlive();
+    PumpForMs(40);
+    bool fired = !f.IsAlive() && v == 10.0;
+    for (AnimHandle& x : hs) x.Cancel(false);
+    Cout() << Format("L52: moved=%d dead=%d stale=%d value=%.1f\n", (int)moved, (int)dead, (int)stale, v);
+    return moved && dead && stale && fired && sched.GetCount() == 1;
+}
+
+// L53 — Property runs: hovering back and forth keeps one run per property
+static bool L53_supersede_property(Probe&) {
+    enum { PROP_INK = 1, PROP_FRAME = 2 };
+    Ctrl owner;
+    owner.SetRect(0, 0, 100, 100);
+    Animation::Scheduler& sched = Animation::Scheduler::Default();
+    const int base = sched.GetCount();
+    double v = 0, jump = 0;
+    Event<const double&> set = [&](const double& x) { jump = max(jump, fabs(x - v)); v = x; };
+    AnimHandle first = AnimateValue<double>(owner, PROP_INK, set, 0.0, 100.0, 200);
+    AnimHandle h;
+    bool one = true;
+    for (int i = 0; i < 40; ++i) {                       // hover in/out at input rate
+        h = AnimateValue<double>(owner, PROP_INK, set, i & 1 ? 100.0 : 0.0, i & 1 ? 0.0 : 100.0, 200);
+        PumpForMs(3);
+        one = one && sched.GetCount() == base + 1;
+    }
+    AnimHandle other = AnimateValue<double>(owner, PROP_FRAME, Event<const double&>([](const double&) {}), 0.0, 1.0, 200);
+    bool keyed = h == first && sched.FindProperty(owner, PROP_INK) == h && other != h
+                 && sched.GetCount() == base + 2;
+    Animation::KillAllFor(owner);
+    Cout() << Format("L53: runs=%d max_jump=%.1f\n", sched.GetCount() - base, jump);
+    return one && keyed && jump < 50 && !h.IsAlive();
+}
+
+// A user value type with no ValueTraits specialization (lerp fallback).
+struct V2 {
+    double x = 0, y = 0;
+    V2() {}
+    V2(double x, double y) : x(x), y(y) {}
+    V2 operator+(const V2& b) const { return V2(x + b.x, y + b.y); }
+    V2 operator-(const V2& b) const { return V2(x - b.x, y - b.y); }
+    V2 operator*(double k) const    { return V2(x * k, y * k); }
+};
+
+// L54 — Retarget: same State, continuous value and velocity, lands on target
+static bool L54_retarget_velocity(Probe& p) {
+    // Path math: velocity per ms is the same just before and after.
+    Point pt;
+    ValueTrack<Point> tr(p.owner, [&](const Point& q) { pt = q; }, Point(0, 0), Point(300, 100));
+    Easing::Fn ease = Easing::InOutCubic();
+    double x0[2], v0[2], x1[2], v1[2];
+    const double s = 0.4, old_ms = 400, new_ms = 250;
+    for (int i = 0; i < 2; ++i) {                  // old path: from + delta * E(s)
+        x0[i] = tr.from[i] + tr.delta[i] * ease(s);
+        v0[i] = tr.delta[i] * (ease(s + 0.05) - ease(s - 0.05)) / 0.1 / old_ms;
+    }
+    tr.Retarget(Point(-50, 200), s, old_ms, new_ms, true, ease);
+    tr.Eval(0, x1, v1);
+    double dv = 0, dx = 0;
+    for (int i = 0; i < 2; ++i) {
+        dx = max(dx, fabs(x1[i] - x0[i]));
+        dv = max(dv, fabs(v1[i] / new_ms - v0[i]) / max(1e-9, fabs(v0[i])));
+    }
+    tr.Eval(1, x1, nullptr);
+    bool lands = fabs(x1[0] + 50) < 1e-9 && fabs(x1[1] - 200) < 1e-9 && !ease;
+
+    // Live run: retargeting reuses the run and ends on the new target.
+    Animation::Scheduler sched;
+    double v = 0;
+    Animation a(p.owner, sched);
+    a.Value<double>([&](const double& x) { v = x; }, 0.0, 100.0).Duration(60).Play();
+    AnimHandle h = a.GetHandle();
+    PumpForMs(sched, 20);
+    bool ok = true;
+    for (int i = 0; i < 20; ++i)                   // pointer-rate retargets
+        ok = a.Retarget(200.0 + i) && ok;
+    bool same = a.GetHandle() == h && sched.GetCount() == 1 && a.GetLastSpec()->easing;
+    PumpForMs(sched, 100);
+
+    V2 w;                                          // no component view: lerped
+    Animation b(p.owner, sched);
+    b.Value<V2>([&](const V2& q) { w = q; }, V2(0, 0), V2(10, -4)).Duration(40).Play();
+    PumpForMs(sched, 60);
+    bool lerped = w.x == 10 && w.y == -4 && !b.IsPlaying();
+    Cout() << Format("L54: dx=%.3f dv=%.3f end=%.1f\n", dx, dv, v);
+    return dx < 1e-9 && dv < 0.15 && lands && ok && same && v == 219.0 && !a.IsPlaying() && lerped;
+}
+
+// L55 — Springs: closed form solves the ODE, SetTarget keeps x and v, rests on target
+static bool L55_spring_runs(Probe& p) {
+    double resid = 0;                               // m x'' + c x' + k (x - to) ~ 0
+    for (double damping : { 10.0, 40.0, 120.0 }) {  // under-, critically, over-damped
+        Animation::Staging spec;
+        spec.kind = Animation::RUN_SPRING;
+        spec.from = 0; spec.to = 100; spec.velocity = 300;
+        spec.stiffness = 400; spec.damping = damping;
+        Animation::State st;
+        st.spec = Animation::SpecRef::Make(pick(spec));
+        st.Seed();
+        for (int t = 10; t < 600; t += 37) {
+            double x, v, xa, va, xb, vb;
+            st.Sample(t, x, v); st.Sample(t - 1, xa, va); st.Sample(t + 1, xb, vb);
+            const double acc = (vb - va) / 0.002;
+            resid = max(resid, fabs(acc + damping * v + 400 * (x - 100)) / 40000);
+        }
+    }
+
+    Animation::Staging damp;                        // critically damped follower retarget
+    damp.kind = Animation::RUN_SPRING; damp.stiffness = 400; damp.damping = 40;
+    Animation::State f;
+    f.spec = Animation::SpecRef::Make(pick(damp));
+    double x1, v1, x2, v2;
+    f.Seed();
+    f.Sample(150, x1, v1);
+    f.SetTarget(-20, 150);                          // start_ms 0: run time == now
+    f.Sample(150, x2, v2);
+    bool continuous = fabs(x1 - x2) < 1e-9 && fabs(v1 - v2) < 1e-9 && f.target == -20;
+
+    Animation::Scheduler sched;
+    double last = 0, peak = 0;
+    Animation a(p.owner, sched);
+    a.Spring(1600, 40).Range(0, 100).Rest(0.5)
+     ([&](double x) { last = x; peak = max(peak, x); return true; }).Play();
+    PumpForMs(sched, 120);
+    bool moving = a.IsPlaying() && a.Progress() > 0.5;
+    PumpForMs(sched, 400);
+    Cout() << Format("L55: resid=%.2g peak=%.1f last=%.1f\n", resid, peak, last);
+    return resid < 0.01 && continuous && moving && peak > 100 && last == 100 && !a.IsPlaying();
+}
+
+// L56 — Decay (fling): end known up front, exact end time, bound spring settles
+static bool L56_decay_fling(Probe& p) {
+    bool ends = Animation::DecayEnd(0, 1000, 4) == 250 && Animation::DecayEnd(0, 1000, 4, 0, 100) == 100
+                && Animation::DecayEnd(-30, 1000, 4, 0, 100) == 0;
+
+    Animation::Staging spec;                        // closed form: rests at end_ms
+    spec.kind = Animation::RUN_DECAY;
+    spec.from = 0; spec.velocity = 1000; spec.friction = 4; spec.rest = 0.5;
+    Animation::State st;
+    st.spec = Animation::SpecRef::Make(pick(spec));
+    st.Seed();
+    double x, v;
+    st.Sample(int64(st.end_ms), x, v);
+    bool exact = st.target == 250 && fabs(fabs(x - 250) - 0.5) < 0.01;
+
+    Animation::Scheduler sched;                     // fling past the bound, spring back
+    double peak = 0, last = 0;
+    int frames = 0;
+    Animation a(p.owner, sched);
+    a.Decay(0, 2000, 8).Spring(1600, 80).Bounds(0, 100).Rest(0.5)
+     ([&](double x) { peak = max(peak, x); last = x; ++frames; return true; }).Play();
+    bool known = a.GetHandle().GetTarget() == 100 && a.GetHandle().GetEndTime() < 0;
+    Animation b(p.owner, sched);
+    b.Decay(0, 1000, 4).Rest(0.5)([](double) { return true; }).Play();
+    int64 end = b.GetHandle().GetEndTime();
+    bool timed = end >= sched.FrameTime() + int64(st.end_ms) && end <= sched.FrameTime() + int64(st.end_ms) + 1;
+    b.Cancel();
+    PumpForMs(sched, 400);
+
+    Animation::SetMotionMode(Animation::MOTION_REDUCED); // same resting point, a quarter of the time
+    Animation c(p.owner, sched);
+    c.Decay(0, 1000, 4).Rest(0.5)([](double) { return true; }).Play();
+    const int64 reduced = c.GetHandle().GetEndTime() - sched.FrameTime();
+    bool quarter = c.GetHandle().GetTarget() == 250 && reduced >= int64(st.end_ms / 4) - 1
+                   && reduced <= int64(st.end_ms / 4) + 1;
+    c.Cancel();
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    Cout() << Format("L56: peak=%.1f last=%.1f frames=%d reduced end=%d ms\n", peak, last, frames, (int)reduced);
+    return ends && exact && known && timed && peak > 100 && last == 100 && !a.IsPlaying() && quarter;
+}
+
+// L57 — Linked runs: progress follows a ProgressSource, timer never armed
+static bool L57_linked_progress(Probe& p) {
+    Animation::Scheduler sched;
+    Vector<double> seen;
+    int cancels = 0;
+    bool ok;
+    Animation a(p.owner, sched);
+    {
+        ProgressSource src;
+        src.Range(0, 200);                          // whole timeline: two 100 ms yoyo legs
+        a.Duration(100).Loop(2).Yoyo().Ease([](double t) { return t; }).Link(src)
+         .OnCancel([&] { ++cancels; })([&](double e) { seen.Add(e); return true; }).Play();
+        bool armed = sched.IsRunning();
+        for (double v : { 50.0, 150.0, 150.0, 250.0, 100.0, -10.0 })
+            src.Set(v);
+        PumpForMs(sched, 30);                       // frames do not step a linked run
+        auto near = [&](int i, double v) { return i < seen.GetCount() && fabs(seen[i] - v) < 1e-9; };
+        ok = !armed && !sched.IsRunning() && seen.GetCount() == 6 && a.IsPlaying()
+             && near(0, 0) && near(1, 0.5) && near(2, 0.5) && near(3, 0) && near(4, 1) && near(5, 0)
+             && src.GetLinkCount() == 1;
+    }                                               // source gone: run cancelled silently
+    Cout() << Format("L57: ticks=%d cancels=%d live=%d\n", seen.GetCount(), cancels, sched.GetCount());
+    return ok && cancels == 0 && sched.GetCount() == 0 && !a.IsPlaying();
+}
+
+// L58 — Clock slaving: drift slewed within max_slew, seeks jump and fire on_seek
+static bool L58_clock_slaving(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetVirtualClock();
+    double ext = 5000;                              // external clock, runs 2% fast
+    int64  jumped = 0;
+    sched.SetClockSource([&] { return ext; }, 0.05, 250, [&](int64 ms) { jumped += ms; });
+    bool aligned = sched.Now() == 5000;
+
+    double worst = 0;                               // run clock rate vs wall, per 4 ms frame
+    int64  last_run = sched.Now();
+    for (int i = 0; i < 75; ++i) {
+        ext += 4 * 1.02;
+        sched.AdvanceTime(4, 4);
+        int64 run = sched.FrameTime();
+        worst = max(worst, fabs(double(run - last_run - 4)) - 0.05 * 4);
+        last_run = run;
+    }
+    bool tracked = fabs(sched.GetClockError()) <= 3 && sched.GetSeekCount() == 0;
+
+    bool finished = false;
+    Animation a(p.owner, sched);
+    a.Duration(2000).OnFinish([&] { finished = true; })([](double) { return true; }).Play();
+    ext += 10000;                                   // the player seeks ahead 10 s
+    sched.Tick();
+    const int seeks = sched.GetSeekCount();
+    int64 t0 = sched.Now();
+    sched.SetClockSource(Function<double()>());    // detach: no jump
+    Cout() << Format("L58: worst=%.2f jumped=%d seeks=%d\n", worst, (int)jumped, seeks);
+    return aligned && tracked && worst <= 1 && seeks == 1 && jumped >= 10000 && jumped <= 10010
+           && finished && abs(int(sched.Now() - t0)) <= 1;
+}
+
+// L59 — Virtual clock: an hour of frames without sleeping, identical every time
+static bool L59_virtual_clock(Probe& p) {
+    auto run = [&](double& sum, int& legs, int& frames) {
+        Animation::Scheduler sched;
+        Animation a(p.owner, sched);
+        a([&](double e) { sum += e; ++frames; return true; })
+         .OnLeg([&](int n) { legs += n + 1; }).Loop(-1).Yoyo().Duration(1000).Play();
+        sched.AdvanceTime(3600 * 1000, 16);         // one hour at ~60 FPS
+        bool on = sched.IsVirtualClock() && a.IsPlaying();
+        a.Cancel();
+        return on;
+    };
+    double s1 = 0, s2 = 0;
+    int legs1 = 0, legs2 = 0, f1 = 0, f2 = 0;
+    const int64 t0 = usecs();
+    bool on = run(s1, legs1, f1) && run(s2, legs2, f2);
+    const int64 spent = (usecs() - t0) / 1000;
+    Cout() << Format("L59: frames=%d legs=%d (%d ms wall for 2 h simulated)\n", f1, legs1, (int)spent);
+    return on && s1 == s2 && legs1 == legs2 && f1 == f2 && f1 == 225000 && legs1 == 3600;
+}
+
+// L60 — Cap policies differ for a mid-priority newcomer: {0, 5} + 3
+static bool L60_cap_policies_differ(Probe& p) {
+    auto run = [&](int policy, bool& admitted, bool& low_kept) {
+        Animation::Scheduler sched;
+        sched.SetMaxActive(2, policy);
+        Animation low(p.owner, sched), high(p.owner, sched), mid(p.owner, sched);
+        low([](double) { return true; }).Priority(0).Duration(300).Play();
+        high([](double) { return true; }).Priority(5).Duration(300).Play();
+        mid([](double) { return true; }).Priority(3).Duration(300).Play();
+        admitted = mid.IsPlaying();
+        low_kept = low.IsPlaying();
+        return high.IsPlaying() && sched.GetCount() == 2;
+    };
+    bool lowest_in, lowest_kept, reject_in, reject_kept;
+    bool ok = run(Animation::CAP_EVICT_LOWEST, lowest_in, lowest_kept)
+              && run(Animation::CAP_REJECT_NEW, reject_in, reject_kept);
+    Cout() << Format("L60: evict-lowest admits=%d, reject-new admits=%d\n", (int)lowest_in, (int)reject_in);
+    return ok && lowest_in && !lowest_kept && !reject_in && reject_kept;
+}
+
+// L61 — Fixed step after an idle gap: a new run starts at the current time
+static bool L61_fixed_step_idle_gap(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetFixedStep(100);                        // 10 ms steps, up to 8 per frame
+    sched.SetIdleGrace(0);
+    Animation a(p.owner, sched);
+    a([](double) { return true; }).Duration(30).Play();
+    PumpForMs(sched, 60);                           // finishes; the scheduler goes idle
+    bool idle = !sched.IsRunning();
+    sched.SetVirtualClock(false);
+    Sleep(300);                                     // wall time passes without frames
+    Vector<double> seen;
+    Animation b(p.owner, sched);
+    b([&](double e) { seen.Add(e); return true; }).Ease([](double t) { return t; }).Duration(200).Play();
+    for (int i = 0; i < 50 && seen.IsEmpty(); ++i) { Sleep(4); sched.Tick(); }
+    b.Cancel();
+    const double shown = seen.GetCount() ? seen.Top() : -1.0; // value the first frame shows
+    Cout() << Format("L61: first frame e=%.2f after %d steps\n", shown, seen.GetCount());
+    return idle && seen.GetCount() && shown <= 0.15;
+}
+
+// L62 — A frame hook keeps the timer at every frame next to a MaxRate run
+static bool L62_hooks_not_rate_limited(Probe& p) {
+    Animation::Scheduler sched;
+    Animation a(p.owner, sched);
+    a([](double) { return true; }).MaxRate(10).Duration(1000).Play();
+    auto longest = [&] {                           // longest sleep over a 10 Hz period
+        int ms = 0;
+        for (int i = 0; i < 7; ++i) {
+            sched.AdvanceTime(16, 16);
+            ms = max(ms, sched.GetWakeDelay());
+        }
+        return ms;
+    };
+    const int grouped = longest();                 // sleeps until the 10 Hz group
+    int calls = 0;
+    int id = sched.OnFrame(p.owner, [&](int64, double) { ++calls; return true; });
+    const int hooked = longest();
+    sched.CancelFrame(id);
+    const int after = longest();
+    a.Cancel();
+    Cout() << Format("L62: wake %d -> %d -> %d ms, hook calls=%d\n", grouped, hooked, after, calls);
+    return grouped > 1000 / 60 && hooked == 1000 / 60 && after > 1000 / 60 && calls == 7;
+}
+
+// L63 — Progress() is per leg: loop and yoyo runs report 1.0 only at the end
+static bool L63_leg_progress(Probe& p) {
+    Animation::Scheduler sched;
+    double e = -1;
+    Animation a(p.owner, sched);
+    a([&](double x) { e = x; return true; }).Ease([](double t) { return t; }).Duration(100).Loop(-1).Play();
+    sched.AdvanceTime(150, 150);                   // halfway through the second leg
+    const double looping = a.Progress();
+    a.Cancel();
+    const double cached = a.Progress();
+    Animation b(p.owner, sched);
+    b([](double) { return true; }).Duration(100).Loop(2).Yoyo().Play();
+    sched.AdvanceTime(150, 150);
+    const double back = b.Progress();              // on the way back
+    sched.AdvanceTime(100, 100);
+    const bool ended = !b.IsPlaying() && b.Progress() == 1.0;
+    Cout() << Format("L63: e=%.2f progress=%.2f cached=%.2f yoyo=%.2f\n", e, looping, cached, back);
+    return fabs(e - 0.5) < 0.02 && fabs(looping - e) < 0.02 && fabs(cached - e) < 0.02
+           && fabs(back - 0.5) < 0.02 && ended;
+}
+
+// L64 — Removing the last run keeps the timer while a frame hook is subscribed
+static bool L64_hook_outlives_last_run(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetIdleGrace(0);
+    int calls = 0;
+    int id = sched.OnFrame(p.owner, [&](int64, double) { ++calls; return true; });
+    Animation a(p.owner, sched);
+    a([](double) { return true; }).Duration(1000).Play();
+    PumpForMs(sched, 20);
+    a.Cancel();                                     // outside a frame: last run removed
+    const bool kept = sched.IsRunning();
+    sched.CancelFrame(id);
+    PumpForMs(sched, 20);                           // hook gone: now it disarms
+    Cout() << Format("L64: running after cancel=%d, after unsubscribe=%d, hook calls=%d\n",
+                     (int)kept, (int)sched.IsRunning(), calls);
+    return kept && calls > 0 && !sched.IsRunning();
+}
+
+// L65 — A slot recycled through all its generations is retired, not wrapped
+static bool L65_slot_generation_retires(Probe& p) {
+    Animation::Scheduler sched;
+    const dword mask = (1u << AnimHandle::INDEX_BITS) - 1;
+    AnimHandle stale = sched.Launch(p.owner, Animation::Staging());
+    const dword slot = stale.GetId() & mask;
+    stale.Cancel(false);
+    int period = 0;                                 // launches until the slot comes back
+    for (bool back = false; !back; ++period) {
+        AnimHandle h = sched.Launch(p.owner, Animation::Staging());
+        back = (h.GetId() & mask) == slot;
+        h.Cancel(false);
+    }
+    int reuses = 1;
+    bool aliased = false;
+    for (int i = period * (1 << AnimHandle::GEN_BITS); i > 0 && !aliased; --i) {
+        AnimHandle h = sched.Launch(p.owner, Animation::Staging());
+        reuses += (h.GetId() & mask) == slot;
+        aliased = h == stale || stale.IsAlive();
+        h.Cancel(false);
+    }
+    Cout() << Format("L65: slot reused %d times, stale handle aliased=%d\n", reuses, (int)aliased);
+    return !aliased && reuses < (1 << AnimHandle::GEN_BITS) && sched.GetCount() == 0;
+}
+
+// L66 — Retarget on a yoyo's return leg continues from the value shown
+static bool L66_retarget_looping(Probe& p) {
+    Animation::Scheduler sched;
+    double v = 0, jump = 0;
+    Animation a(p.owner, sched);
+    a.Value<double>([&](const double& x) { jump = max(jump, fabs(x - v)); v = x; }, 0.0, 100.0)
+     .Ease([](double t) { return t; }).Duration(100).Loop(-1).Yoyo().Play();
+    PumpForMs(sched, 175);                          // back leg, 3/4 through: 25 and falling
+    const double shown = v;
+    jump = 0;
+    bool ok = a.Retarget(200.0, Animation::RETARGET_KEEP_END);
+    sched.AdvanceTime(1, 1);
+    const bool falling = v < shown;                 // velocity kept, direction included
+    PumpForMs(sched, 15);
+    const bool alive = a.IsPlaying();               // rest of the leg (25 ms), not 1 ms
+    PumpForMs(sched, 40);
+    Cout() << Format("L66: shown=%.1f jump=%.2f end=%.1f\n", shown, jump, v);
+    return ok && fabs(shown - 25) < 1.5 && falling && jump < 12 && alive && v == 200.0 && !a.IsPlaying();
+}
+
+// L67 — Switching to instant motion leaves no timer armed with nothing to tick
+static bool L67_instant_disarms(Probe& p) {
+    Animation::Scheduler sched;
+    sched.SetIdleGrace(500);
+    Animation a(p.owner, sched);
+    a([](double) { return true; }).Duration(300).Play();
+    PumpForMs(sched, 20);
+    Animation::SetMotionMode(Animation::MOTION_INSTANT);
+    const bool snapped = !a.IsPlaying() && a.Progress() == 1.0;
+    const bool disarmed = !sched.IsRunning();
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    int id = sched.OnFrame(p.owner, [](int64, double) { return true; });
+    a.Play();
+    Animation::SetMotionMode(Animation::MOTION_INSTANT);
+    const bool hooked = sched.IsRunning();          // the hook still wants frames
+    Animation::SetMotionMode(Animation::MOTION_FULL);
+    sched.CancelFrame(id);
+    Cout() << Format("L67: snapped=%d running=%d, with hook=%d\n", (int)snapped, (int)!disarmed, (int)hooked);
+    return snapped && disarmed && hooked;
+}
+
 // ---------- minimal runner ----------
 namespace {
 struct TestSummary { int total=0, passed=0, failed=0; };
@@ -549,6 +1434,41 @@ bool RunProbe()
 		{ 30, "Replay() allows overriding spec via setters",            true,  L30_replay_after_setters_override,  nullptr },
 		{ 31, "Reset() primes staging and zeros Progress()",            true,  L31_reset_primes_staging_and_zeros_progress, nullptr },
 		{ 32, "Replay() Confirm restart immediately,no double-schedule",true,  L32_replay_interrupts_running, nullptr },
+		{ 33, "SetMaxActive evicts oldest run (finish semantics)",      true,  L33_max_active_evicts_oldest,       nullptr },
+		{ 34, "CAP_REJECT_NEW refuses low-priority newcomers",          true,  L34_max_active_rejects_low_priority, nullptr },
+		{ 35, "Private Scheduler runs independently of default",        true,  L35_private_scheduler,              nullptr },
+		{ 36, "Scheduler Suspend/Resume freezes clock in place",        true,  L36_suspend_resume_scheduler,       nullptr },
+		{ 37, "Visibility culling skips ticks, catches up when shown",  true,  L37_visibility_culling,             nullptr },
+		{ 38, "Batch avoids timer churn; idle grace then disarms",      true,  L38_batch_and_idle_grace,           nullptr },
+		{ 39, "Stall across loop legs resolves in a single frame",      true,  L39_stall_catch_up,                 nullptr },
+		{ 40, "Fixed-step sim values independent of frame rate",        true,  L40_fixed_step_frame_rate_independent, nullptr },
+		{ 41, "MaxRate() throttles updates, still finishes on time",    true,  L41_max_rate_groups,                nullptr },
+		{ 42, "Auto-FPS governor lowers under load, recovers after",    true,  L42_auto_fps_governor,              nullptr },
+		{ 43, "Frame source switch; FrameStats jitter percentiles",     true,  L43_frame_source,                   nullptr },
+		{ 44, "Immediate(): t=0 frame inside Play(); global default",   true,  L44_immediate_first_frame,          nullptr },
+		{ 45, "FrameTime(): lockstep starts; Progress == frame value",  true,  L45_frame_time,                     nullptr },
+		{ 46, "OnFrame(): shared timestamp, unsubscribe, owner death",  true,  L46_frame_hooks,                    nullptr },
+		{ 47, "Motion modes: instant, snap in flight, reduced timing",  true,  L47_motion_mode,                    nullptr },
+		{ 48, "PlayMany(): shared spec, factory ticks, stagger",        true,  L48_play_many,                      nullptr },
+		{ 49, "Copy-on-write specs shared by run/last spec/Replay",     true,  L49_shared_specs,                   nullptr },
+		{ 50, "Idle Animations share the default spec until a setter", true,  L50_default_spec_shared,            nullptr },
+		{ 51, "Hooks use inline callables and member delegates",       true,  L51_small_function_hooks,           nullptr },
+		{ 52, "Generational handles; Animations move explicitly",      true,  L52_generational_handles,           nullptr },
+		{ 53, "Same-property runs supersede; one run per key",         true,  L53_supersede_property,             nullptr },
+		{ 54, "Retarget keeps State, value and velocity continuous",   true,  L54_retarget_velocity,              nullptr },
+		{ 55, "Closed-form springs: exact, retargetable, rest at end", true,  L55_spring_runs,                    nullptr },
+		{ 56, "Decay fling: known end, exact end time, bound spring",  true,  L56_decay_fling,                    nullptr },
+		{ 57, "Linked runs: source-driven progress, no frame timer",   true,  L57_linked_progress,                nullptr },
+		{ 58, "Clock slaving: slewed drift, seeks as discontinuities", true,  L58_clock_slaving,                  nullptr },
+		{ 59, "Virtual clock: simulated hours, deterministic",         true,  L59_virtual_clock,                  nullptr },
+		{ 60, "Cap policies: REJECT_NEW needs to outrank every run",   true,  L60_cap_policies_differ,            nullptr },
+		{ 61, "Fixed step: no catch-up burst after an idle gap",       true,  L61_fixed_step_idle_gap,            nullptr },
+		{ 62, "Frame hooks keep every frame beside MaxRate runs",      true,  L62_hooks_not_rate_limited,         nullptr },
+		{ 63, "Progress() is per leg for loop and yoyo runs",          true,  L63_leg_progress,                   nullptr },
+		{ 64, "Frame hooks keep the timer after the last run ends",    true,  L64_hook_outlives_last_run,         nullptr },
+		{ 65, "Run slots retire at the last generation, never wrap",   true,  L65_slot_generation_retires,        nullptr },
+		{ 66, "Retarget a looping run from its current leg",           true,  L66_retarget_looping,               nullptr },
+		{ 67, "Instant motion mode disarms an idle scheduler",         true,  L67_instant_disarms,                nullptr },
     };
 
     Cout() << "Headless Test Suite for Animation Library\n";
@@ -493,6 +493,7 @@ public:
     // Global controls
     DropList   dd_playback;
     DropList   dd_easing;
+    DropList   dd_source;
     EditInt    ed_duration;
     Button     bt_start, bt_pause, bt_reset, bt_replay;
     StaticText lb_status;
@@ -550,6 +551,13 @@ public:
 		bt_replay.WhenPush = [=]{ ReplayAll(); };
 		y += h + gap;
 
+        Add(dd_source.LeftPos(x, w).TopPos(y, h));
+        dd_source.Add(Animation::Scheduler::FRAME_TIMER, "Frames: TimeCallback");
+        dd_source.Add(Animation::Scheduler::FRAME_TIMERFD, "Frames: timerfd");
+        dd_source <<= Animation::Scheduler::FRAME_TIMER;
+        dd_source.WhenAction = [=]{ ApplyFrameSource(); };
+        y += h + gap;
+
 
         Add(lb_status.LeftPos(x, w).TopPos(y, h));
         lb_status.SetText("Idle");
@@ -667,6 +675,15 @@ private:
         }
     }
 
+    // Frame source comparison: switch the default scheduler and restart the
+    // jitter histogram (p99 shows in the status line).
+    void ApplyFrameSource() {
+        Animation::Scheduler& s = Animation::Scheduler::Default();
+        if (!s.SetFrameSource(~dd_source))
+            dd_source <<= s.GetFrameSource(); // timerfd unavailable here
+        s.ResetFrameStats();
+    }
+
     void TogglePauseContinue() {
         bool any_paused = false;
         for (const Demo& d : demos) if (d.anim && d.anim->IsPaused()) { any_paused = true; break; }
@@ -701,7 +718,8 @@ private:
                     if (s >= 0.25) {
                         int fps = int(fps_frames / s + 0.5);
                         fps_frames = 0; fps_ts.Reset();
-                        lb_status.SetText(Format("Running — FPS ~ %d", fps));
+                        int p99 = Animation::Scheduler::Default().GetFrameStats().Percentile(0.99);
+                        lb_status.SetText(Format("Running — FPS ~ %d, p99 %d us", fps, p99));
                     }
                 }
                 return true;